@@ -62,6 +62,9 @@
 #define OPCODE_MT_HI      0x40
 #define OPCODE_MT_LO      0x60
 
+#define MEASUREMENT_TIME_LOW_MAX_MS  24
+#define MEASUREMENT_TIME_HIGH_MAX_MS 180
+
 #define I2C_FREQ_HZ 400000
 
 static const char *TAG = "bh1750";
@@ -151,6 +154,16 @@ esp_err_t bh1750_setup(i2c_dev_t *dev, bh1750_mode_t mode, bh1750_resolution_t r
     return ESP_OK;
 }
 
+esp_err_t bh1750_start_measurement(i2c_dev_t *dev, bh1750_resolution_t resolution)
+{
+    return bh1750_setup(dev, BH1750_MODE_ONE_TIME, resolution);
+}
+
+uint32_t bh1750_measurement_time_ms(bh1750_resolution_t resolution)
+{
+    return resolution == BH1750_RES_LOW ? MEASUREMENT_TIME_LOW_MAX_MS : MEASUREMENT_TIME_HIGH_MAX_MS;
+}
+
 esp_err_t bh1750_set_measurement_time(i2c_dev_t *dev, uint8_t time)
 {
     CHECK_ARG(dev);
@@ -167,15 +180,24 @@ esp_err_t bh1750_read(i2c_dev_t *dev, uint16_t *level)
 {
     CHECK_ARG(dev && level);
 
+    CHECK(bh1750_read_raw(dev, level));
+    // FIX: Correct conversion to LUX for high resolution modes
+    *level = (uint16_t)((float)*level / 1.2f);
+
+    return ESP_OK;
+}
+
+esp_err_t bh1750_read_raw(i2c_dev_t *dev, uint16_t *raw)
+{
+    CHECK_ARG(dev && raw);
+
     uint8_t buf[2];
 
     I2C_DEV_TAKE_MUTEX(dev);
     I2C_DEV_CHECK(dev, i2c_dev_read(dev, NULL, 0, buf, 2));
     I2C_DEV_GIVE_MUTEX(dev);
 
-    *level = buf[0] << 8 | buf[1];
-    // FIX: Correct conversion to LUX for high resolution modes
-    *level = (uint16_t)((float)*level / 1.2f);
+    *raw = buf[0] << 8 | buf[1];
 
     return ESP_OK;
 }
@@ -122,6 +122,27 @@ esp_err_t bh1750_power_on(i2c_dev_t *dev);
  */
 esp_err_t bh1750_setup(i2c_dev_t *dev, bh1750_mode_t mode, bh1750_resolution_t resolution);
 
+/**
+ * @brief Start a single measurement
+ *
+ * The device powers down by itself once the conversion is done. Wait
+ * bh1750_measurement_time_ms() before reading the result with bh1750_read().
+ * The bus is free while the conversion runs.
+ *
+ * @param dev Pointer to device descriptor
+ * @param resolution Measurement resolution
+ * @return `ESP_OK` on success
+ */
+esp_err_t bh1750_start_measurement(i2c_dev_t *dev, bh1750_resolution_t resolution);
+
+/**
+ * @brief Maximum conversion time for a resolution at the default measurement time
+ *
+ * @param resolution Measurement resolution
+ * @return Time in milliseconds, from the datasheet maximums
+ */
+uint32_t bh1750_measurement_time_ms(bh1750_resolution_t resolution);
+
 /**
  * @brief Set measurement time
  *
@@ -140,6 +161,18 @@ esp_err_t bh1750_set_measurement_time(i2c_dev_t *dev, uint8_t time);
  */
 esp_err_t bh1750_read(i2c_dev_t *dev, uint16_t *level);
 
+/**
+ * @brief Read the raw 16-bit count from the device, without lux conversion.
+ *
+ * The count depends on the resolution and measurement time in use; see the
+ * datasheet for the conversion.
+ *
+ * @param dev Pointer to device descriptor
+ * @param[out] raw Raw count
+ * @return `ESP_OK` on success
+ */
+esp_err_t bh1750_read_raw(i2c_dev_t *dev, uint16_t *raw);
+
 #ifdef __cplusplus
 }
 #endif
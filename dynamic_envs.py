@@ -47,10 +47,69 @@ try:
     night_end_hour = config.get(sensor_env, "night_end_hour", fallback="4")
     local_timezone = config.get(sensor_env, "local_timezone", fallback="CST6CDT,M3.2.0/2,M11.1.0/2")
 
+    # Optional location: night follows sunset/sunrise instead of the fixed night hours
+    latitude = config.get(sensor_env, "latitude", fallback="")
+    longitude = config.get(sensor_env, "longitude", fallback="")
+    sun_margin_minutes = config.get(sensor_env, "sun_margin_minutes", fallback="0")
+    dark_lux_threshold = config.get(sensor_env, "dark_lux_threshold", fallback="0")
+
+    # WiFi between sends: cycle (stop the radio), stay (modem sleep), auto (stay unless on battery)
+    wifi_power_mode = config.get(sensor_env, "wifi_power_mode", fallback="cycle").strip().lower()
+    wifi_listen_interval = config.get(sensor_env, "wifi_listen_interval", fallback="3")
+    wifi_adaptive_tx_power = config.getboolean(sensor_env, "wifi_adaptive_tx_power", fallback=True)
+
+    # Light sub-samples per reading, reduced to mean/min/max/stddev/integral
+    light_subsamples = config.get(sensor_env, "light_subsamples", fallback="1")
+
+    # Reading interval bounds in seconds; it shortens while the light changes quickly
+    sample_interval_min_s = config.get(sensor_env, "sample_interval_min_s", fallback="15")
+    sample_interval_max_s = config.get(sensor_env, "sample_interval_max_s", fallback="15")
+
+    # Drop readings the server can interpolate to within this many lux; 0 sends everything
+    compression_max_error_lux = config.get(sensor_env, "compression_max_error_lux", fallback="0")
+
+    # On battery, deep sleep between daytime samples instead of staying awake
+    daytime_deep_sleep = config.getboolean(sensor_env, "daytime_deep_sleep", fallback=False)
+
+    # Set the clock from API response headers, with SNTP only as a fallback
+    http_time_source = config.getboolean("all_sensors", "http_time_source", fallback=False)
+    http_time_header = config.get("all_sensors", "http_time_header", fallback="")
+
 except configparser.NoOptionError as e:
     print(f"Error: Missing configuration in section '[{sensor_env}]'. {e}")
     env.Exit(1)
 
+has_location = bool(latitude and longitude)
+if bool(latitude) != bool(longitude):
+    print("Error: latitude and longitude must be set together.")
+    env.Exit(1)
+
+if not light_subsamples.isdigit() or not 1 <= int(light_subsamples) <= 15:
+    print(f"Error: light_subsamples must be between 1 and 15, got '{light_subsamples}'.")
+    env.Exit(1)
+
+if not (sample_interval_min_s.isdigit() and sample_interval_max_s.isdigit()) or \
+        not int(light_subsamples) <= int(sample_interval_min_s) <= int(sample_interval_max_s) <= 300:
+    print(f"Error: sample_interval_min_s ({sample_interval_min_s}) and sample_interval_max_s ({sample_interval_max_s}) "
+          f"must satisfy light_subsamples <= min <= max <= 300.")
+    env.Exit(1)
+
+# Readings land on wall-clock multiples of the interval, so both bounds must divide an hour evenly
+aligned_intervals = [1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60, 120, 180, 240, 300]
+if int(sample_interval_min_s) not in aligned_intervals or int(sample_interval_max_s) not in aligned_intervals:
+    print(f"Error: sample_interval_min_s ({sample_interval_min_s}) and sample_interval_max_s ({sample_interval_max_s}) "
+          f"must each be one of {', '.join(map(str, aligned_intervals))}.")
+    env.Exit(1)
+
+if not compression_max_error_lux.isdigit():
+    print(f"Error: compression_max_error_lux must be a whole number of lux, got '{compression_max_error_lux}'.")
+    env.Exit(1)
+
+wifi_power_modes = {"cycle": 0, "stay": 1, "auto": 2}
+if wifi_power_mode not in wifi_power_modes:
+    print(f"Error: wifi_power_mode must be one of {', '.join(wifi_power_modes)}, got '{wifi_power_mode}'.")
+    env.Exit(1)
+
 # Create a header file instead of using build flags
 header_content = f'''/**
  * Auto-generated configuration file
@@ -69,6 +128,21 @@ header_content = f'''/**
 #define CONFIG_NIGHT_START_HOUR {night_start_hour}
 #define CONFIG_NIGHT_END_HOUR {night_end_hour}
 #define CONFIG_LOCAL_TIMEZONE "{local_timezone}"
+#define CONFIG_HAS_LOCATION {1 if has_location else 0}
+#define CONFIG_LATITUDE {float(latitude) if has_location else 0.0}
+#define CONFIG_LONGITUDE {float(longitude) if has_location else 0.0}
+#define CONFIG_SUN_MARGIN_MINUTES {int(sun_margin_minutes)}
+#define CONFIG_DARK_LUX_THRESHOLD {float(dark_lux_threshold)}f
+#define CONFIG_WIFI_POWER_MODE {wifi_power_modes[wifi_power_mode]}
+#define CONFIG_WIFI_LISTEN_INTERVAL {wifi_listen_interval}
+#define CONFIG_WIFI_ADAPTIVE_TX_POWER {1 if wifi_adaptive_tx_power else 0}
+#define CONFIG_LIGHT_SUBSAMPLES {light_subsamples}
+#define CONFIG_SAMPLE_INTERVAL_MIN_S {sample_interval_min_s}
+#define CONFIG_SAMPLE_INTERVAL_MAX_S {sample_interval_max_s}
+#define CONFIG_COMPRESSION_MAX_ERROR_LUX {compression_max_error_lux}
+#define CONFIG_DAYTIME_DEEP_SLEEP {1 if daytime_deep_sleep else 0}
+#define CONFIG_HTTP_TIME_SOURCE {1 if http_time_source else 0}
+#define CONFIG_HTTP_TIME_HEADER "{http_time_header}"
 
 // Helper macros
 #define CONFIG_HAS_BATTERY_CIRCUIT (CONFIG_BATTERY_ADC_GPIO >= 0)
@@ -89,4 +163,15 @@ print(f"  - SCL_GPIO: {scl_gpio}")
 print(f"  - BATTERY_ADC_GPIO: {battery_adc_gpio} ({'enabled' if int(battery_adc_gpio) >= 0 else 'disabled'})")
 print(f"  - NIGHT_START_HOUR: {night_start_hour}")
 print(f"  - NIGHT_END_HOUR: {night_end_hour}")
-print(f"  - LOCAL_TIMEZONE: {local_timezone}")
\ No newline at end of file
+print(f"  - LOCAL_TIMEZONE: {local_timezone}")
+print(f"  - LOCATION: {f'{latitude}, {longitude}' if has_location else 'not set (fixed night hours)'}")
+print(f"  - SUN_MARGIN_MINUTES: {sun_margin_minutes}")
+print(f"  - DARK_LUX_THRESHOLD: {dark_lux_threshold}")
+print(f"  - WIFI_POWER_MODE: {wifi_power_mode}")
+print(f"  - WIFI_LISTEN_INTERVAL: {wifi_listen_interval}")
+print(f"  - WIFI_ADAPTIVE_TX_POWER: {wifi_adaptive_tx_power}")
+print(f"  - LIGHT_SUBSAMPLES: {light_subsamples}")
+print(f"  - SAMPLE_INTERVAL: {sample_interval_min_s}-{sample_interval_max_s} s")
+print(f"  - COMPRESSION_MAX_ERROR_LUX: {compression_max_error_lux}")
+print(f"  - DAYTIME_DEEP_SLEEP: {daytime_deep_sleep}")
+print(f"  - HTTP_TIME_SOURCE: {http_time_source} (header: {http_time_header or 'Date only'})")
\ No newline at end of file
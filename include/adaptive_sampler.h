@@ -0,0 +1,75 @@
+/**
+* @file adaptive_sampler.h
+ *
+ * Reading interval that follows how fast the light level is changing.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Adaptive interval state
+ */
+typedef struct {
+    uint32_t min_ms;
+    uint32_t max_ms;
+    uint32_t interval_ms;   // Delay before the next reading
+    float last_lux;
+    bool has_last;
+} adaptive_sampler_t;
+
+/**
+ * @brief Check whether an interval keeps readings on wall-clock boundaries
+ *
+ * @param interval_s Interval in seconds
+ * @return true if the interval divides an hour evenly and is at most 300 s
+ */
+bool adaptive_sampler_is_aligned(uint32_t interval_s);
+
+/**
+ * @brief Start at the shortest interval with no previous reading
+ *
+ * Equal bounds give a fixed interval. Bounds that don't divide an hour evenly
+ * are rounded inward to ones that do.
+ *
+ * @param sampler State to initialize
+ * @param min_s Shortest interval in seconds, used while the light changes quickly
+ * @param max_s Longest interval in seconds, reached while the light is steady
+ */
+void adaptive_sampler_init(adaptive_sampler_t *sampler, uint32_t min_s, uint32_t max_s);
+
+/**
+ * @brief Forget the previous reading, for example after the night pause
+ *
+ * @param sampler Adaptive interval state
+ */
+void adaptive_sampler_restart(adaptive_sampler_t *sampler);
+
+/**
+ * @brief Get the delay before the next reading
+ *
+ * @param sampler Adaptive interval state
+ * @return Interval in milliseconds
+ */
+uint32_t adaptive_sampler_interval_ms(const adaptive_sampler_t *sampler);
+
+/**
+ * @brief Adjust the interval from a new reading
+ *
+ * Halves the interval when the light moved by more than 10% since the
+ * previous reading and stretches it by half when it moved by less than 2%,
+ * rounded to the nearest interval that divides an hour evenly in that
+ * direction (15 s halves to 6 s and stretches to 30 s).
+ *
+ * @param sampler Adaptive interval state, updated
+ * @param lux The new reading
+ */
+void adaptive_sampler_update(adaptive_sampler_t *sampler, float lux);
@@ -14,6 +14,7 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "i2cdev.h" // Use the i2cdev descriptor type
 #include "sensor_data.h"
 
@@ -27,5 +28,6 @@ typedef struct {
     int buffer_size;
     SemaphoreHandle_t buffer_mutex;
     bool wifi_send_failed;  // Flag to indicate if the last WiFi send failed
+    TaskHandle_t send_task_handle;  // Notified when the reading buffer passes its high-water mark
 } app_context_t;
 
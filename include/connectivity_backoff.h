@@ -0,0 +1,36 @@
+/**
+* @file connectivity_backoff.h
+ *
+ * Adaptive backoff for WiFi connection attempts when the access point is unreachable.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Check whether a connection attempt should be made this send cycle
+ *
+ * @return true if the backoff interval has elapsed (or no failures are recorded)
+ */
+bool connectivity_backoff_should_attempt(void);
+
+/**
+ * @brief Get the number of 2-second connection polls to spend on the next attempt
+ *
+ * @return Full budget when the network has been reliable, less after repeated failures
+ */
+int connectivity_backoff_get_attempt_budget(void);
+
+/**
+ * @brief Record the outcome of a connection attempt
+ *
+ * @param connected true if WiFi connected, false if the attempt timed out
+ */
+void connectivity_backoff_record_result(bool connected);
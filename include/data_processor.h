@@ -23,6 +23,15 @@
  */
 bool data_processor_init(void);
 
+/**
+ * @brief Correct buffered and stored timestamps after a sync found clock drift
+ *
+ * Call after each time sync and before uploading.
+ *
+ * @param context Application context containing the shared buffer
+ */
+void apply_pending_time_correction(app_context_t *context);
+
 /**
  * @brief Process buffered sensor readings with automatic buffer management
  *
@@ -41,6 +50,19 @@ bool process_buffered_readings(app_context_t *context, bool (*processor)(sensor_
  */
 bool send_readings_processor(sensor_reading_t* readings, int count);
 
+/**
+ * @brief Processor function to send sensor readings, saving them if the send fails
+ *
+ * For draining the shared buffer, which is emptied before the send starts:
+ * readings that can't be sent go to persistent storage for backfill instead
+ * of being dropped.
+ *
+ * @param readings Array of sensor readings
+ * @param count Number of readings
+ * @return true if the readings were sent, false if they were saved instead or lost
+ */
+bool send_or_save_readings_processor(sensor_reading_t* readings, int count);
+
 /**
  * @brief Processor function to save sensor readings to persistent storage
  *
@@ -51,8 +73,20 @@ bool send_readings_processor(sensor_reading_t* readings, int count);
 bool save_readings_processor(sensor_reading_t* readings, int count);
 
 /**
- * @brief Send all stored readings and clear storage on success
+ * @brief Check whether persistent storage holds any readings
+ *
+ * @return true if at least one reading is stored
+ */
+bool has_stored_readings(void);
+
+/**
+ * @brief Send stored readings newest batch first, within a per-cycle budget
+ *
+ * Call after the current readings have been sent, so an outage backlog
+ * doesn't delay them. Sends up to six stored batches or 20 seconds' worth,
+ * whichever comes first, removing each batch once it is sent. Skipped
+ * while the clock is not set or the battery is low.
  *
- * @return true if successful or no readings to send, false on error
+ * @return true if successful or nothing was due, false on error
  */
-bool send_all_stored_readings(void);
\ No newline at end of file
+bool backfill_stored_readings(void);
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+* @file dns_cache.h
+ *
+ * RTC-memory cache of the API host address so DNS survives WiFi power cycles.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Look up a host name in the cache
+ *
+ * @param name Host name being resolved
+ * @param[out] addr IPv4 address in network byte order
+ * @return true if the name matches the cached API host and the entry has not expired
+ */
+bool dns_cache_lookup(const char *name, uint32_t *addr);
+
+/**
+ * @brief Resolve and store the API host address if the cache is empty or expired
+ *
+ * Call after a successful request, when lwIP's own DNS table still holds the answer.
+ */
+void dns_cache_refresh(void);
+
+/**
+ * @brief Drop the cached address so the next connection re-resolves it
+ */
+void dns_cache_invalidate(void);
@@ -0,0 +1,69 @@
+/**
+* @file duty_cycle.h
+ *
+ * Daytime deep sleep between samples for battery-powered sensors.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include "app_context.h"
+#include "sensor_data.h"
+#include <stdbool.h>
+
+/**
+ * @brief Check whether daytime deep sleep is configured and possible
+ *
+ * Needs CONFIG_DAYTIME_DEEP_SLEEP, an ESP32-C3 and a detected battery.
+ *
+ * @return true if the device should sleep between samples during the day
+ */
+bool duty_cycle_is_enabled(void);
+
+/**
+ * @brief Handle a wake from sleep between samples
+ *
+ * Call at the top of app_main, before NVS and the rest of the application
+ * is initialized. Takes one reading into the RTC buffer and goes back to
+ * sleep without returning, unless an upload is due or sampling is not
+ * possible right now (night, invalid clock). Returns immediately on any
+ * other kind of boot.
+ */
+void duty_cycle_handle_wake(void);
+
+/**
+ * @brief Check whether this boot was woken to upload the RTC buffer
+ *
+ * @return true if the buffer filled or the send interval elapsed
+ */
+bool duty_cycle_is_upload_wake(void);
+
+/**
+ * @brief Send the readings collected while asleep, or save them on failure
+ *
+ * @param connected Whether the network is up
+ */
+void duty_cycle_flush_readings(bool connected);
+
+/**
+ * @brief Apply a clock correction to the readings taken while sleeping
+ *
+ * @param correction Correction window and offset from the last sync
+ * @return Number of readings whose timestamp changed
+ */
+int duty_cycle_correct_timestamps(const time_correction_t *correction);
+
+/**
+ * @brief Start sleeping between samples if the conditions allow it
+ *
+ * Moves any readings in the shared buffer into RTC memory first. Does not
+ * return if the device goes to sleep.
+ *
+ * @param context Application context containing the shared buffer
+ */
+void duty_cycle_sleep_if_enabled(app_context_t *context);
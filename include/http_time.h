@@ -0,0 +1,47 @@
+/**
+* @file http_time.h
+ *
+ * Wall-clock time taken from API response headers.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Mark the start of a request round trip (call when the request headers are sent)
+ */
+void http_time_request_start(void);
+
+/**
+ * @brief Inspect a response header for server time
+ *
+ * @param key Header name
+ * @param value Header value
+ */
+void http_time_on_header(const char *key, const char *value);
+
+/**
+ * @brief Finish the round trip and keep a time sample if the server answered
+ *
+ * @param server_answered true if an HTTP response was received
+ */
+void http_time_request_end(bool server_answered);
+
+/**
+ * @brief Correct the system clock from the most recent response, if recent enough
+ *
+ * Steps the clock only when the measured offset exceeds the sample's uncertainty.
+ *
+ * @param max_age_s Ignore samples older than this many seconds
+ * @param offset_us Receives the measured offset (server minus local), may be NULL
+ * @return true if the clock now agrees with the server within the sample's uncertainty
+ */
+bool http_time_apply(uint32_t max_age_s, int64_t *offset_us);
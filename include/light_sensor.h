@@ -14,6 +14,7 @@
 
 #include "i2cdev.h"
 #include "esp_err.h"
+#include <stdint.h>
 
 /**
  * @brief Initializes the BH1750 light sensor.
@@ -24,7 +25,32 @@
 esp_err_t init_light_sensor(i2c_dev_t **dev);
 
 /**
- * @brief Reads the ambient light from the BH1750 sensor.
+ * @brief Starts a one-time measurement on the BH1750 sensor.
+ *
+ * The I2C bus is released straight away. The sensor converts for up to
+ * ready_in_ms, then powers itself down; read the result with get_ambient_light().
+ *
+ * @param dev Pointer to the initialized sensor's device descriptor.
+ * @param[out] ready_in_ms Time until the result is ready.
+ * @return esp_err_t ESP_OK on success, error code on failure.
+ */
+esp_err_t start_ambient_light(i2c_dev_t *dev, uint32_t *ready_in_ms);
+
+/**
+ * @brief Blocks the calling task until a started measurement is ready.
+ *
+ * @param started_us esp_timer_get_time() just before start_ambient_light().
+ * @param ready_in_ms Time returned by start_ambient_light().
+ */
+void wait_for_ambient_light(int64_t started_us, uint32_t ready_in_ms);
+
+/**
+ * @brief Reads the result of the last measurement from the BH1750 sensor.
+ *
+ * Measurements are auto-ranged: each reading picks the resolution and
+ * measurement time for the next one, covering roughly 0.1 lx to 120 klx.
+ * A saturated reading is measured again in a wider range before returning;
+ * if that measurement fails, the error is returned rather than the clipped value.
  *
  * @param dev Pointer to the initialized sensor's device descriptor.
  * @param[out] lux Pointer to a float where the light level in Lux will be stored.
@@ -32,3 +58,15 @@ esp_err_t init_light_sensor(i2c_dev_t **dev);
  */
 esp_err_t get_ambient_light(i2c_dev_t *dev, float *lux);
 
+/**
+ * @brief Takes a single measurement without init_light_sensor(), for short wakes.
+ *
+ * For wakes that only need one value. The sensor powers itself down after a
+ * one-time measurement, so nothing needs to be stopped afterwards. The range
+ * is limited to conversions of 180 ms or less to keep the wake short.
+ *
+ * @param[out] lux Pointer to a float where the light level in Lux will be stored.
+ * @return esp_err_t ESP_OK on success, error code on failure.
+ */
+esp_err_t read_ambient_light_once(float *lux);
+
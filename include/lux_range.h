@@ -0,0 +1,102 @@
+/**
+* @file lux_range.h
+ *
+ * Auto-ranging for the BH1750: resolution and measurement time chosen from the last reading.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LUX_RANGE_MTREG_DEFAULT 69
+#define LUX_RANGE_MTREG_MIN 31
+#define LUX_RANGE_MTREG_MAX 254
+
+/**
+ * @brief BH1750 resolution modes, mirrored so this module has no driver dependency
+ */
+typedef enum {
+    LUX_RES_LOW,        // 4 lx steps, 24 ms at the default measurement time
+    LUX_RES_HIGH,       // 1 lx steps, 180 ms
+    LUX_RES_HIGH2       // 0.5 lx steps, 180 ms
+} lux_resolution_t;
+
+/**
+ * @brief One sensor configuration
+ */
+typedef struct {
+    lux_resolution_t resolution;
+    uint8_t mtreg;      // Measurement time register, 31-254
+} lux_range_setting_t;
+
+/**
+ * @brief Auto-ranging state
+ */
+typedef struct {
+    int step;           // Index into the range ladder, 0 is the most sensitive
+} lux_range_t;
+
+/**
+ * @brief Start in the middle of the ladder (high resolution, default measurement time)
+ *
+ * @param range State to initialize
+ */
+void lux_range_init(lux_range_t *range);
+
+/**
+ * @brief Get the sensor configuration for the next measurement
+ *
+ * @param range Auto-ranging state
+ * @return Resolution and measurement time register to use
+ */
+lux_range_setting_t lux_range_setting(const lux_range_t *range);
+
+/**
+ * @brief Maximum conversion time of a configuration
+ *
+ * @param setting Sensor configuration
+ * @return Time in milliseconds, from the datasheet maximums scaled by MTreg
+ */
+uint32_t lux_range_conversion_ms(lux_range_setting_t setting);
+
+/**
+ * @brief Keep the next measurement within a conversion time
+ *
+ * Moves to the most sensitive step that converts within max_ms if the
+ * current one is slower, for example HIGH2 at MTreg 254 (about 663 ms).
+ * The least sensitive step is used if none fits.
+ *
+ * @param range Auto-ranging state, updated
+ * @param max_ms Longest acceptable conversion in milliseconds
+ */
+void lux_range_limit_conversion(lux_range_t *range, uint32_t max_ms);
+
+/**
+ * @brief Convert a raw count to lux using the datasheet sensitivity
+ *
+ * lux = count / 1.2 * (69 / MTreg), halved again in HIGH2 mode.
+ *
+ * @param setting Configuration the count was measured with
+ * @param raw Raw 16-bit count
+ * @return Light level in lux
+ */
+float lux_range_to_lux(lux_range_setting_t setting, uint16_t raw);
+
+/**
+ * @brief Pick the configuration for the next measurement from this count
+ *
+ * Moves to a less sensitive step near full scale and to a more sensitive
+ * one when the count would still fit there with headroom.
+ *
+ * @param range Auto-ranging state, updated
+ * @param raw Raw count measured with the current step
+ * @return true if the count was saturated and should be measured again
+ */
+bool lux_range_update(lux_range_t *range, uint16_t raw);
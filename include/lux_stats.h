@@ -0,0 +1,60 @@
+/**
+* @file lux_stats.h
+ *
+ * Running statistics over the light sub-samples behind one reported reading.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include "sensor_data.h"
+#include <stdint.h>
+
+/**
+ * @brief Welford accumulator: mean and variance in one pass, without keeping the samples
+ */
+typedef struct {
+    uint16_t count;
+    float mean;
+    float m2;           // Sum of squared differences from the running mean
+    float min;
+    float max;
+    float integral;     // Lux seconds
+} lux_stats_t;
+
+/**
+ * @brief Start a new reporting interval
+ *
+ * @param stats Accumulator to clear
+ */
+void lux_stats_reset(lux_stats_t *stats);
+
+/**
+ * @brief Add one sub-sample
+ *
+ * @param stats Accumulator
+ * @param lux Light level of the sub-sample
+ * @param duration_s Time the sub-sample stands for, for the light integral
+ */
+void lux_stats_add(lux_stats_t *stats, float lux, float duration_s);
+
+/**
+ * @brief Sample standard deviation of the sub-samples so far
+ *
+ * @param stats Accumulator
+ * @return Standard deviation in lux, 0 with fewer than two sub-samples
+ */
+float lux_stats_stddev(const lux_stats_t *stats);
+
+/**
+ * @brief Fill the light fields of a reading from the accumulator
+ *
+ * @param stats Accumulator with at least one sub-sample
+ * @param reading Reading to fill: lux (the mean), min, max, standard deviation, integral and count
+ */
+void lux_stats_to_reading(const lux_stats_t *stats, sensor_reading_t *reading);
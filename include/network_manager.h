@@ -14,12 +14,33 @@
 
 #include <time.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 
+// Values for CONFIG_WIFI_POWER_MODE in generated_config.h
+#define WIFI_POWER_MODE_CYCLE 0
+#define WIFI_POWER_MODE_STAY 1
+#define WIFI_POWER_MODE_AUTO 2
+
+/**
+ * @brief How the radio is handled between send cycles
+ */
+typedef enum {
+    CONNECTIVITY_MODE_CYCLE,  // Stop the WiFi driver after every send
+    CONNECTIVITY_MODE_STAY    // Stay associated in max modem sleep
+} connectivity_mode_t;
+
+/**
+ * @brief Get the connectivity mode, resolving "auto" by battery presence on first call
+ */
+connectivity_mode_t network_get_connectivity_mode(void);
+
 /**
  * @brief Initialize network connection (WiFi)
  *
- * @param max_retries Maximum number of connection attempts
+ * In stay mode an existing association is reused without touching the driver.
+ *
+ * @param max_retries Maximum number of connection attempts (2 s each)
  * @return true if connected successfully, false otherwise
  */
 bool initialize_network_connection(int max_retries);
@@ -41,5 +62,16 @@ void handle_ntp_sync(time_t *last_ntp_sync_time, bool is_initial_boot);
 
 /**
  * @brief Disconnect WiFi to save power
+ *
+ * In stay mode a live association is kept in modem sleep instead.
  */
-void disconnect_wifi_for_power_saving(void);
\ No newline at end of file
+void disconnect_wifi_for_power_saving(void);
+
+/**
+ * @brief Format connect latency, radio time and estimated charge since boot
+ *
+ * @param buffer Output buffer
+ * @param buffer_size Size of output buffer
+ */
+void format_connectivity_report(char *buffer, size_t buffer_size);
+
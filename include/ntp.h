@@ -13,13 +13,72 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "sensor_data.h"
 
 /**
  * @brief Initialize SNTP and synchronize time
+ *
+ * Returns as soon as the first SNTP response sets the clock (60 s timeout).
+ *
  * @return true if time synchronization was successful, false otherwise
  */
 bool initialize_sntp(void);
 
+/**
+ * @brief Step the clock by an offset measured outside SNTP
+ *
+ * Records the correction and sync time the same way an SNTP sync does. The
+ * offset only moves the drift estimate if its uncertainty is small compared
+ * with the time since the last sync.
+ *
+ * @param offset_us Server time minus local clock
+ * @param uncertainty_us How far the measured offset may be off
+ * @return true if the clock was stepped, false otherwise
+ */
+bool ntp_apply_offset(int64_t offset_us, int64_t uncertainty_us);
+
+/**
+ * @brief Record a sync that found the clock within the measurement's uncertainty
+ *
+ * The clock is left alone, but the sync time and drift estimate are updated
+ * as for a sync that stepped it, so a device kept in time this way doesn't
+ * report stale sync state.
+ *
+ * @param offset_us Server time minus local clock, as measured
+ * @param uncertainty_us How far the measured offset may be off
+ */
+void ntp_confirm_offset(int64_t offset_us, int64_t uncertainty_us);
+
+/**
+ * @brief Take the clock correction from the last sync, if readings need adjusting
+ *
+ * Only set when a sync moved an already-valid clock by half a second or more.
+ *
+ * @param correction Receives the correction window and offset
+ * @return true if a correction was pending (it is cleared), false otherwise
+ */
+bool ntp_take_time_correction(time_correction_t *correction);
+
+/**
+ * @brief Get the correction applied by the last successful sync
+ * @return Offset in microseconds (server time minus local clock)
+ */
+int64_t ntp_get_last_offset_us(void);
+
+/**
+ * @brief Get the smoothed clock drift estimate
+ * @param drift_ppm Receives the drift in parts per million
+ * @return true if enough syncs have been seen to estimate drift
+ */
+bool ntp_get_drift_ppm(float *drift_ppm);
+
+/**
+ * @brief Get how long the clock can run before the next sync is due
+ * @return Interval in seconds, derived from measured drift (1 hour until known)
+ */
+uint32_t ntp_get_next_sync_interval_s(void);
+
 /**
  * @brief Check if the system time is valid (reasonable timestamp)
  * @return true if system time appears valid, false otherwise
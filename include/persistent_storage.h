@@ -44,6 +44,33 @@ esp_err_t persistent_storage_save_readings(const sensor_reading_t* readings, int
  */
 esp_err_t persistent_storage_load_readings(sensor_reading_t* readings, int max_count, int* loaded_count);
 
+/**
+ * @brief Load the most recently saved batch of readings
+ *
+ * With readings NULL, only reports the size and index of the newest batch,
+ * so the caller can allocate exactly enough for it.
+ *
+ * @param readings Buffer to store the batch, or NULL to query its size
+ * @param max_count Maximum number of readings the buffer can hold, ignored for a size query
+ * @param loaded_count Output parameter - number of readings loaded, or in the batch for a
+ *                     size query; 0 if storage is empty
+ * @param batch_index Output parameter - index of the batch, for persistent_storage_remove_batch()
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE if the batch doesn't fit
+ */
+esp_err_t persistent_storage_load_newest_batch(sensor_reading_t* readings, int max_count,
+                                               int* loaded_count, int* batch_index);
+
+/**
+ * @brief Remove one batch of readings
+ *
+ * Batches saved after it are unaffected, so readings stored while the batch
+ * was being sent are not lost.
+ *
+ * @param batch_index Index returned by persistent_storage_load_newest_batch()
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t persistent_storage_remove_batch(int batch_index);
+
 /**
  * @brief Clear all stored readings from persistent storage
  *
@@ -57,4 +84,23 @@ esp_err_t persistent_storage_clear_readings(void);
  * @param count Output parameter - number of stored readings
  * @return esp_err_t ESP_OK on success
  */
-esp_err_t persistent_storage_get_count(int* count);
\ No newline at end of file
+esp_err_t persistent_storage_get_count(int* count);
+
+/**
+ * @brief Apply a clock correction to readings in memory
+ *
+ * @param readings Array of sensor readings, corrected in place
+ * @param count Number of readings in the array
+ * @param correction Correction window and offset
+ * @return Number of readings whose timestamp changed
+ */
+int persistent_storage_correct_timestamps(sensor_reading_t* readings, int count,
+                                          const time_correction_t* correction);
+
+/**
+ * @brief Rewrite stored readings with a clock correction
+ *
+ * @param correction Correction window and offset
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t persistent_storage_apply_time_correction(const time_correction_t* correction);
@@ -0,0 +1,57 @@
+/**
+* @file pm_control.h
+ *
+ * Dynamic frequency scaling, automatic light sleep and the PM locks around peripheral work.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+/**
+ * @brief Work that must not run at a reduced clock or be interrupted by light sleep
+ */
+typedef enum {
+    PM_LOCK_I2C,    // Light sensor transactions, which need a steady APB clock
+    PM_LOCK_ADC,    // Battery voltage sampling
+    PM_LOCK_HTTP,   // TLS handshake and request, CPU bound
+    PM_LOCK_COUNT
+} pm_lock_id_t;
+
+/**
+ * @brief Enable frequency scaling and automatic light sleep, and create the locks
+ *
+ * Without CONFIG_PM_ENABLE this does nothing and the locks are no-ops.
+ *
+ * @return ESP_OK on success, error code otherwise
+ */
+esp_err_t pm_control_init(void);
+
+/**
+ * @brief Hold the clock up and keep the chip out of light sleep
+ *
+ * @param lock Which kind of work is starting
+ */
+void pm_control_acquire(pm_lock_id_t lock);
+
+/**
+ * @brief Release a lock taken with pm_control_acquire()
+ *
+ * @param lock Which kind of work finished
+ */
+void pm_control_release(pm_lock_id_t lock);
+
+/**
+ * @brief Log the time spent in each power mode
+ *
+ * Needs CONFIG_PM_PROFILING; otherwise logs nothing.
+ *
+ * @return Percent of the time since boot spent in light sleep, -1 if unknown
+ */
+int pm_control_log_stats(void);
@@ -33,6 +33,14 @@ uint64_t calculate_sleep_duration_us(void);
  */
 void enter_night_sleep(void);
 
+/**
+ * @brief Fast path for a night timer wake that arrived before the night ended
+ *
+ * Call first thing in app_main. If the planned wake came early because of RTC
+ * drift, goes straight back to deep sleep for the remainder and does not return.
+ */
+void handle_early_night_wake(void);
+
 /**
  * @brief Check and log the reason for waking up from deep sleep
  * @return The wakeup cause
@@ -0,0 +1,37 @@
+/**
+* @file reading_buffer.h
+ *
+ * Sizing of the shared reading buffer and the mark at which the send task drains it early.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#define READING_BUFFER_MIN_SIZE 8
+#define READING_BUFFER_HIGH_WATER_PERCENT 75
+
+/**
+ * @brief Buffer size for two send intervals at the shortest reading interval
+ *
+ * An on-time send then never meets the high-water mark. Long reading
+ * intervals would give a buffer of two or three, so there is a floor.
+ */
+#define READING_BUFFER_SIZE_FOR(send_interval_s, min_interval_s) \
+    ((2 * (send_interval_s) / (min_interval_s)) > READING_BUFFER_MIN_SIZE ? \
+     (2 * (send_interval_s) / (min_interval_s)) : READING_BUFFER_MIN_SIZE)
+
+/**
+ * @brief Get the reading count at which the send task is woken to drain the buffer
+ *
+ * 75% of the buffer, but at least two readings and short of full, so a
+ * small buffer doesn't wake the send task for the first reading of a cycle.
+ *
+ * @param buffer_size Capacity of the buffer in readings
+ * @return Count at which to notify, once, as the buffer fills
+ */
+int reading_buffer_high_water_mark(int buffer_size);
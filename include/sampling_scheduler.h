@@ -0,0 +1,58 @@
+/**
+* @file sampling_scheduler.h
+ *
+ * Readings on wall-clock boundaries, with a histogram of how late each one fires.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Get the current wall-clock time
+ *
+ * @return Milliseconds since the epoch
+ */
+int64_t sampling_scheduler_now_ms(void);
+
+/**
+ * @brief Get the next wall-clock multiple of a period
+ *
+ * A 15 second period gives :00, :15, :30 and :45 of each minute.
+ *
+ * @param now_ms Current time in milliseconds since the epoch
+ * @param period_ms Period in milliseconds
+ * @return First multiple of period_ms strictly after now_ms
+ */
+int64_t sampling_scheduler_next_boundary_ms(int64_t now_ms, uint32_t period_ms);
+
+/**
+ * @brief Block until a wall-clock time
+ *
+ * The remaining time is measured against the wall clock again after each
+ * delay, so an NTP correction during the wait moves the wake with it. How
+ * late the wake is goes into the jitter histogram. If the target is ever
+ * more than max_wait_ms away, the clock stepped back and the wait is
+ * abandoned; it counts as a clock step.
+ *
+ * @param target_ms Time to wake in milliseconds since the epoch
+ * @param max_wait_ms Longest the target can legitimately be away, usually one interval
+ * @return false without waiting if the time has already passed, or if the wait was abandoned
+ */
+bool sampling_scheduler_wait_until(int64_t target_ms, uint32_t max_wait_ms);
+
+/**
+ * @brief Format the wake jitter histogram since boot
+ *
+ * @param buffer Output buffer
+ * @param buffer_size Size of output buffer
+ */
+void sampling_scheduler_format_jitter(char *buffer, size_t buffer_size);
@@ -0,0 +1,67 @@
+/**
+* @file send_schedule.h
+ *
+ * Per-device upload phase and jittered retries, so a fleet that boots together doesn't send together.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Source of uniformly distributed 32-bit random numbers, such as esp_random
+ */
+typedef uint32_t (*send_schedule_random_t)(void);
+
+/**
+ * @brief Get a sensor's fixed offset within the send interval
+ *
+ * @param sensor_id Sensor ID to hash
+ * @param interval_s Send interval in seconds
+ * @return Offset in seconds, in [0, interval_s)
+ */
+uint32_t send_schedule_phase_s(const char *sensor_id, uint32_t interval_s);
+
+/**
+ * @brief Get the time of the next send cycle for this device
+ *
+ * Send cycles fall on this device's phase within each interval of wall-clock
+ * time, plus a few seconds of random jitter.
+ *
+ * @param sensor_id Sensor ID that picks the phase
+ * @param now Current time
+ * @param interval_s Send interval in seconds
+ * @param next_random Source of the jitter
+ * @return Time of the next send cycle, after now
+ */
+time_t send_schedule_next_send_time(const char *sensor_id, time_t now, uint32_t interval_s,
+                                    send_schedule_random_t next_random);
+
+/**
+ * @brief Get the delay before retrying a failed request
+ *
+ * Doubles with each attempt from 5 seconds, and is drawn at random from the
+ * upper half of that so retries from different devices drift apart.
+ *
+ * @param attempt The attempt that just failed, starting at 1
+ * @param next_random Source of the jitter
+ * @return Delay in milliseconds
+ */
+uint32_t send_schedule_retry_delay_ms(int attempt, send_schedule_random_t next_random);
+
+/**
+ * @brief Get a random delay before the first connection after power-on
+ *
+ * @param power_on Whether this boot followed a power-on or brownout reset
+ * @param next_random Source of the delay
+ * @return Delay in milliseconds, up to 30 seconds after power-on and 0 otherwise
+ */
+uint32_t send_schedule_boot_delay_ms(bool power_on, send_schedule_random_t next_random);
@@ -14,6 +14,7 @@
 
 #include <time.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Structure to hold a single sensor reading for batching.
@@ -23,4 +24,26 @@ typedef struct {
     float lux;
     float chip_temp_c;  // Celsius
     float chip_temp_f;  // Fahrenheit
+    int64_t mono_us;    // esp_timer_get_time() when the reading was taken
+    uint32_t boot_id;   // Boot the mono_us value belongs to
+    bool provisional;   // Taken before the wall clock was valid; timestamp is not usable yet
+    float lux_min;      // Light statistics over the sub-samples behind lux, which is their mean
+    float lux_max;
+    float lux_stddev;
+    float lux_integral; // Lux seconds over the reading interval
+    uint16_t sample_count;
 } sensor_reading_t;
+
+/**
+ * @brief Clock correction measured at a time sync.
+ *
+ * The clock error is taken to grow linearly from zero at window_start (the
+ * previous sync) to offset_us at window_end (the local clock at this sync,
+ * or the corrected time if that is earlier, so readings taken after a
+ * backward step are not shifted).
+ */
+typedef struct {
+    time_t window_start;
+    time_t window_end;
+    int64_t offset_us;  // Server time minus local clock
+} time_correction_t;
@@ -20,6 +20,14 @@
  */
 void send_device_status_if_appropriate(void);
 
+/**
+ * @brief Send the connectivity, light sleep and sampling jitter figures once an hour
+ *
+ * Timed by the wall clock, so the hour carries across deep sleep; call once
+ * per send cycle while connected.
+ */
+void send_hourly_report_if_due(void);
+
 /**
  * @brief Send status update with retry mechanism
  *
@@ -0,0 +1,47 @@
+/**
+* @file sun_schedule.h
+ *
+ * Sunrise and sunset times from the NOAA solar position equations.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <time.h>
+
+// Standard sunrise/sunset zenith: 90 degrees plus refraction and the solar disc radius
+#define SUN_ZENITH_OFFICIAL 90.833
+
+/**
+ * @brief Kind of day at a location
+ */
+typedef enum {
+    SUN_DAY_NORMAL,         // Sun rises and sets
+    SUN_DAY_POLAR_NIGHT,    // Sun stays below the zenith all day
+    SUN_DAY_MIDNIGHT_SUN    // Sun stays above the zenith all day
+} sun_day_type_t;
+
+/**
+ * @brief Compute sunrise and sunset for a calendar date
+ *
+ * Pure function with no ESP-IDF dependencies. Times are returned as UTC
+ * instants and may fall on the neighbouring UTC day for far east/west
+ * longitudes. Accurate to about a minute between +/-72 degrees latitude.
+ *
+ * @param year Full year of the date
+ * @param month Month 1-12
+ * @param day Day of month 1-31
+ * @param latitude Degrees, north positive
+ * @param longitude Degrees, east positive
+ * @param zenith_deg Sun zenith angle that counts as rise/set, e.g. SUN_ZENITH_OFFICIAL
+ * @param sunrise Receives the sunrise instant (only for SUN_DAY_NORMAL)
+ * @param sunset Receives the sunset instant (only for SUN_DAY_NORMAL)
+ * @return Kind of day
+ */
+sun_day_type_t sun_schedule_compute(int year, int month, int day, double latitude, double longitude,
+                                    double zenith_deg, time_t *sunrise, time_t *sunset);
@@ -0,0 +1,30 @@
+/**
+* @file swinging_door.h
+ *
+ * Swinging door compression of a batch of readings before upload.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include "sensor_data.h"
+
+/**
+ * @brief Drop the readings a straight line between their neighbours reproduces
+ *
+ * Linear interpolation between the kept readings stays within max_error_lux
+ * of every dropped reading's lux. The first and last readings are always
+ * kept, and so is any reading whose timestamp doesn't move forward. Kept
+ * readings are compacted to the front of the array in their original order.
+ *
+ * @param readings Batch in timestamp order, compacted in place
+ * @param count Number of readings in the batch
+ * @param max_error_lux Error bound; zero or less keeps everything
+ * @return Number of readings kept
+ */
+int swinging_door_compress(sensor_reading_t *readings, int count, float max_error_lux);
@@ -12,4 +12,7 @@
 
 #pragma once
 
+// Notification bits for the send task, set with xTaskNotify(..., eSetBits)
+#define SEND_TASK_NOTIFY_HIGH_WATER (1 << 0)  // Reading buffer is filling up, drain it early
+
 void task_send_data(void *arg);
\ No newline at end of file
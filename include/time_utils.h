@@ -13,28 +13,55 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 
+/**
+ * @brief Initialize time utilities and the timezone table. Call once early in app_main.
+ */
+void time_utils_init(void);
+
+/**
+ * @brief Get a random identifier for this boot
+ *
+ * Monotonic timestamps are only comparable between readings with the same boot ID.
+ *
+ * @return Boot ID chosen by time_utils_init()
+ */
+uint32_t time_utils_get_boot_id(void);
+
 /**
  * @brief Check if it's currently nighttime in the configured local timezone
  *
- * @return true if current local time is between configured night hours
+ * With a configured location, night runs from sunset to sunrise (and may start
+ * early once darkness is observed); otherwise the configured night hours apply.
+ *
+ * @return true if it is currently night
  */
 bool is_nighttime_local(void);
 
+/**
+ * @brief Feed a light reading into the observed-darkness check
+ *
+ * In the evening, consecutive readings below the configured dark threshold start
+ * the night before astronomical sunset. No-op without a configured location.
+ *
+ * @param lux Ambient light in lux
+ */
+void time_utils_observe_lux(float lux);
+
 /**
  * @brief Log the current local time and day/night status
  */
 void log_local_time_status(void);
 
 /**
- * @brief Execute a function with local timezone temporarily set
+ * @brief Execute a function with the current time in the local timezone
  *
- * This helper function temporarily switches to the configured local timezone,
- * gets the current time, calls the provided callback function with local time
- * data, then restores the original timezone.
+ * Converts the current time with the timezone table cached by time_utils_init()
+ * and calls the provided callback function with local time data. Thread safe.
  *
- * @param func Callback function to execute with local timezone active
+ * @param func Callback function to execute with local time
  * @param user_data Optional data pointer passed to the callback function
  */
 void with_local_timezone(void (*func)(const struct tm*, time_t, void*), void* user_data);
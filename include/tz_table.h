@@ -0,0 +1,55 @@
+/**
+* @file tz_table.h
+ *
+ * Precomputed UTC offset and DST transition table built from a POSIX TZ string.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Parse a POSIX TZ string and build the transition table
+ *
+ * Not thread safe; call once before any task uses the lookups. Afterwards the
+ * table is read-only and lookups need no locking.
+ *
+ * @param posix_tz TZ string such as "CST6CDT,M3.2.0/2,M11.1.0/2"
+ * @return true on success; on failure the table falls back to UTC
+ */
+bool tz_table_init(const char *posix_tz);
+
+/**
+ * @brief Get the UTC offset in effect at a given instant
+ *
+ * @param utc Seconds since the epoch
+ * @param is_dst Receives whether daylight saving time is in effect, may be NULL
+ * @return Offset east of UTC in seconds
+ */
+int32_t tz_table_utc_offset(time_t utc, bool *is_dst);
+
+/**
+ * @brief Convert a UTC instant to local broken-down time
+ *
+ * @param utc Seconds since the epoch
+ * @param local_time Receives the local time, with tm_isdst set
+ */
+void tz_table_utc_to_local(time_t utc, struct tm *local_time);
+
+/**
+ * @brief Days since 1970-01-01 for a proleptic Gregorian date
+ *
+ * @param year Full year, e.g. 2025
+ * @param month Month 1-12
+ * @param day Day of month 1-31
+ * @return Day number, negative before 1970
+ */
+int64_t tz_table_days_from_civil(int year, int month, int day);
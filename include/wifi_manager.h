@@ -18,6 +18,9 @@
 
 // Connection management
 void wifi_manager_init(void);
+void wifi_manager_stop(void);
+void wifi_manager_set_power_save(bool enabled, uint16_t listen_interval);
+void wifi_manager_set_idle(bool idle);
 bool wifi_is_connected(void);
 esp_err_t wifi_get_mac_address(char *mac_str);
 
@@ -0,0 +1,39 @@
+/**
+* @file wifi_tx_power.h
+ *
+ * Adaptive WiFi transmit power and PHY mode selection from measured RSSI.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Apply the selected PHY protocols. Call after esp_wifi_init() and before esp_wifi_start().
+ */
+void wifi_tx_power_apply_protocol(void);
+
+/**
+ * @brief Apply the selected maximum TX power. Call after esp_wifi_start().
+ */
+void wifi_tx_power_apply_power(void);
+
+/**
+ * @brief Count a disconnect event against the current power level
+ *
+ * @param was_connected true if an established link dropped, false for a failed connect attempt
+ */
+void wifi_tx_power_note_disconnect(bool was_connected);
+
+/**
+ * @brief Update the RSSI history and pick the power level for the next cycle
+ *
+ * @param connected true if this cycle connected (RSSI is sampled), false if it failed
+ */
+void wifi_tx_power_update(bool connected);
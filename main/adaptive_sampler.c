@@ -0,0 +1,120 @@
+/**
+* @file adaptive_sampler.c
+ *
+ * Reading interval that follows how fast the light level is changing.
+ *
+ * A fixed 15 second interval collects the same reading over and over under
+ * steady overcast or full sun, and can still miss the edges of a passing
+ * cloud. The interval is adjusted after each reading from the relative change
+ * since the previous one: a large change halves it right away, a run of
+ * small changes stretches it step by step. Dim light uses an absolute floor
+ * so sensor noise at dusk doesn't count as fast change.
+ *
+ * Readings land on wall-clock multiples of the interval, so the interval only
+ * takes values that divide an hour evenly (5, 10, 15, 20, 30, 60 s and so on).
+ * Halving or stretching by half moves to the nearest of those; an interval
+ * like 7.5 s would put readings at :07.5 and break the alignment.
+ *
+ * This module has no ESP-IDF dependencies.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "adaptive_sampler.h"
+#include <math.h>
+
+#define FAST_CHANGE 0.10f       // Relative change that halves the interval
+#define STEADY_CHANGE 0.02f     // Relative change below which the interval grows
+#define CHANGE_FLOOR_LUX 20.0f  // Changes are measured against at least this level
+
+// Intervals in seconds that divide an hour evenly, up to the 300 s limit
+static const uint16_t s_aligned_s[] = { 1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60, 120, 180, 240, 300 };
+#define ALIGNED_COUNT ((int)(sizeof(s_aligned_s) / sizeof(s_aligned_s[0])))
+
+/**
+ * @brief Round down to an aligned interval
+ *
+ * @param ms Interval in milliseconds
+ * @return Longest aligned interval in milliseconds no longer than ms, or the shortest one
+ */
+static uint32_t aligned_at_most(uint32_t ms) {
+    uint32_t result = s_aligned_s[0] * 1000;
+    for (int i = 0; i < ALIGNED_COUNT && s_aligned_s[i] * 1000u <= ms; i++) {
+        result = s_aligned_s[i] * 1000;
+    }
+    return result;
+}
+
+/**
+ * @brief Round up to an aligned interval
+ *
+ * @param ms Interval in milliseconds
+ * @return Shortest aligned interval in milliseconds no shorter than ms, or the longest one
+ */
+static uint32_t aligned_at_least(uint32_t ms) {
+    for (int i = 0; i < ALIGNED_COUNT; i++) {
+        if (s_aligned_s[i] * 1000u >= ms) {
+            return s_aligned_s[i] * 1000;
+        }
+    }
+    return s_aligned_s[ALIGNED_COUNT - 1] * 1000;
+}
+
+bool adaptive_sampler_is_aligned(uint32_t interval_s) {
+    for (int i = 0; i < ALIGNED_COUNT; i++) {
+        if (s_aligned_s[i] == interval_s) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void adaptive_sampler_init(adaptive_sampler_t *sampler, uint32_t min_s, uint32_t max_s) {
+    // The build validates both bounds; rounding inward keeps odd values aligned anyway
+    sampler->min_ms = aligned_at_least(min_s * 1000);
+    sampler->max_ms = aligned_at_most(max_s * 1000);
+    if (sampler->max_ms < sampler->min_ms) {
+        sampler->max_ms = sampler->min_ms;
+    }
+    adaptive_sampler_restart(sampler);
+}
+
+void adaptive_sampler_restart(adaptive_sampler_t *sampler) {
+    sampler->interval_ms = sampler->min_ms;
+    sampler->last_lux = 0.0f;
+    sampler->has_last = false;
+}
+
+uint32_t adaptive_sampler_interval_ms(const adaptive_sampler_t *sampler) {
+    return sampler->interval_ms;
+}
+
+void adaptive_sampler_update(adaptive_sampler_t *sampler, float lux) {
+    if (!sampler->has_last) {
+        sampler->last_lux = lux;
+        sampler->has_last = true;
+        return;
+    }
+
+    float reference = fmaxf(fmaxf(sampler->last_lux, lux), CHANGE_FLOOR_LUX);
+    float change = fabsf(lux - sampler->last_lux) / reference;
+    sampler->last_lux = lux;
+
+    uint32_t interval = sampler->interval_ms;
+    if (change > FAST_CHANGE) {
+        interval = aligned_at_most(interval / 2);
+    } else if (change < STEADY_CHANGE) {
+        interval = aligned_at_least(interval + interval / 2);
+    }
+
+    if (interval < sampler->min_ms) {
+        interval = sampler->min_ms;
+    } else if (interval > sampler->max_ms) {
+        interval = sampler->max_ms;
+    }
+    sampler->interval_ms = interval;
+}
@@ -12,6 +12,7 @@
 
 #include "adc_battery.h"
 #include "app_config.h"
+#include "pm_control.h"
 #include "esp_log.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_cali.h"
@@ -121,10 +122,12 @@ esp_err_t adc_battery_get_voltage(float *voltage) {
     int min_raw = 4095;
     int max_raw = 0;
 
+    pm_control_acquire(PM_LOCK_ADC);
     for (int i = 0; i < num_samples; i++) {
         int raw_reading;
         esp_err_t ret = adc_oneshot_read(adc1_handle, battery_adc_channel, &raw_reading);
         if (ret != ESP_OK) {
+            pm_control_release(PM_LOCK_ADC);
             ESP_LOGE(TAG, "Failed to read ADC: %s", esp_err_to_name(ret));
             return ret;
         }
@@ -133,6 +136,7 @@ esp_err_t adc_battery_get_voltage(float *voltage) {
         if (raw_reading > max_raw) max_raw = raw_reading;
         vTaskDelay(pdMS_TO_TICKS(10)); // Small delay between readings
     }
+    pm_control_release(PM_LOCK_ADC);
 
     int avg_raw = total_raw / num_samples;
 
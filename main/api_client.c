@@ -70,6 +70,18 @@ static esp_err_t send_sensor_data_chunk(const sensor_reading_t* readings, int co
             break;
         }
 
+        // Spread of the light sub-samples, only when there was more than one
+        if (readings[i].sample_count > 1 &&
+            (cJSON_AddNumberToObject(sensor_object, "light_min", readings[i].lux_min) == NULL ||
+             cJSON_AddNumberToObject(sensor_object, "light_max", readings[i].lux_max) == NULL ||
+             cJSON_AddNumberToObject(sensor_object, "light_stddev", readings[i].lux_stddev) == NULL ||
+             cJSON_AddNumberToObject(sensor_object, "light_integral", readings[i].lux_integral) == NULL ||
+             cJSON_AddNumberToObject(sensor_object, "light_samples", readings[i].sample_count) == NULL)) {
+            ESP_LOGE(TAG, "Failed to add light statistics to sensor object for reading #%d", i);
+            cJSON_Delete(sensor_object);
+            break;
+        }
+
         if (cJSON_AddItemToArray(root_array, sensor_object) == 0) {
             ESP_LOGE(TAG, "Failed to add sensor object to array for reading #%d", i);
             cJSON_Delete(sensor_object);
@@ -0,0 +1,155 @@
+/**
+* @file connectivity_backoff.c
+ *
+ * Adaptive backoff for WiFi connection attempts when the access point is unreachable.
+ *
+ * Consecutive failures lengthen the interval between attempts and shorten the
+ * time spent on each one. A per-hour availability score learns when the AP is
+ * usually off (for example a router switched off overnight) so those hours go
+ * straight to the longest interval, while hours that are usually fine keep
+ * retrying at close to the normal rate. Any success resets the backoff.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "connectivity_backoff.h"
+#include "app_config.h"
+#include "ntp.h"
+#include "time_utils.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include <time.h>
+
+#define TAG "BACKOFF"
+
+#define BACKOFF_BASE_INTERVAL_S (5 * 60)    // One normal send cycle
+#define BACKOFF_MAX_INTERVAL_S (60 * 60)    // Never go longer than an hour between attempts
+#define BACKOFF_MAX_SHIFT 4                 // 5, 10, 20, 40, 60 minutes
+#define BACKOFF_FULL_BUDGET 15              // 2-second polls, the original fixed budget
+#define BACKOFF_MIN_BUDGET 4
+#define HOUR_SCORE_LIMIT 8                  // Per-hour score is clamped to [-8, 8]
+#define HOUR_UNRELIABLE_SCORE (-4)          // At or below: AP is usually down at this hour
+#define HOUR_RELIABLE_SCORE 4               // At or above: AP is usually up at this hour
+
+/**
+ * @brief Backoff state, kept in RTC memory so it survives night deep sleep
+ */
+typedef struct {
+    uint16_t consecutive_failures;
+    time_t next_attempt_time;
+    int8_t failure_hour;                    // Local hour of the last failure, -1 if unknown
+    int8_t hour_score[24];                  // Learned availability per local hour
+} backoff_state_t;
+
+static RTC_DATA_ATTR backoff_state_t s_state = { .failure_hour = -1 };
+
+/**
+ * @brief Callback to extract the local hour
+ */
+static void local_hour_callback(const struct tm* local_time, time_t now, void* user_data) {
+    *(int*)user_data = local_time->tm_hour;
+}
+
+/**
+ * @brief Get the current local hour, or -1 if the clock has not been set
+ */
+static int get_local_hour(void) {
+    if (!is_system_time_valid()) {
+        return -1;
+    }
+    int hour = -1;
+    with_local_timezone(local_hour_callback, &hour);
+    return hour;
+}
+
+bool connectivity_backoff_should_attempt(void) {
+    if (s_state.consecutive_failures == 0) {
+        return true;
+    }
+
+    time_t now = time(NULL);
+    if (now >= s_state.next_attempt_time) {
+        return true;
+    }
+
+    // Clock was stepped backwards since the failure - don't trust the deadline
+    if (s_state.next_attempt_time - now > BACKOFF_MAX_INTERVAL_S) {
+        ESP_LOGW(TAG, "Backoff deadline is too far ahead (clock change?) - attempting now");
+        return true;
+    }
+
+    // Entering an hour where the AP is normally reachable: recover early
+    int hour = get_local_hour();
+    if (hour >= 0 && hour != s_state.failure_hour && s_state.hour_score[hour] >= HOUR_RELIABLE_SCORE) {
+        ESP_LOGI(TAG, "Hour %02d is usually reachable - attempting before backoff expires", hour);
+        return true;
+    }
+
+    ESP_LOGI(TAG, "Backing off after %u failures - next attempt in %lld s",
+             s_state.consecutive_failures, (long long)(s_state.next_attempt_time - now));
+    return false;
+}
+
+int connectivity_backoff_get_attempt_budget(void) {
+    if (s_state.consecutive_failures == 0) {
+        return BACKOFF_FULL_BUDGET;
+    }
+
+    int hour = get_local_hour();
+    if (hour >= 0 && s_state.hour_score[hour] <= HOUR_UNRELIABLE_SCORE) {
+        return BACKOFF_MIN_BUDGET;
+    }
+
+    int budget = BACKOFF_FULL_BUDGET / (1 + s_state.consecutive_failures);
+    return budget < BACKOFF_MIN_BUDGET ? BACKOFF_MIN_BUDGET : budget;
+}
+
+void connectivity_backoff_record_result(bool connected) {
+    int hour = get_local_hour();
+
+    if (connected) {
+        if (hour >= 0 && s_state.hour_score[hour] < HOUR_SCORE_LIMIT) {
+            s_state.hour_score[hour]++;
+        }
+        if (s_state.consecutive_failures > 0) {
+            ESP_LOGI(TAG, "Connectivity restored after %u failed attempts - backoff reset",
+                     s_state.consecutive_failures);
+        }
+        s_state.consecutive_failures = 0;
+        s_state.next_attempt_time = 0;
+        s_state.failure_hour = -1;
+        return;
+    }
+
+    if (hour >= 0 && s_state.hour_score[hour] > -HOUR_SCORE_LIMIT) {
+        s_state.hour_score[hour]--;
+    }
+    if (s_state.consecutive_failures < UINT16_MAX) {
+        s_state.consecutive_failures++;
+    }
+    s_state.failure_hour = (int8_t)hour;
+
+    int shift = s_state.consecutive_failures - 1;
+    if (shift > BACKOFF_MAX_SHIFT) {
+        shift = BACKOFF_MAX_SHIFT;
+    }
+    int interval_s = BACKOFF_BASE_INTERVAL_S << shift;
+
+    if (hour >= 0 && s_state.hour_score[hour] <= HOUR_UNRELIABLE_SCORE) {
+        interval_s = BACKOFF_MAX_INTERVAL_S;
+    } else if (hour >= 0 && s_state.hour_score[hour] >= HOUR_RELIABLE_SCORE) {
+        // Outage is unusual for this hour - keep checking often so we recover quickly
+        interval_s = BACKOFF_BASE_INTERVAL_S * 2;
+    }
+    if (interval_s > BACKOFF_MAX_INTERVAL_S) {
+        interval_s = BACKOFF_MAX_INTERVAL_S;
+    }
+
+    s_state.next_attempt_time = time(NULL) + interval_s;
+    ESP_LOGW(TAG, "Connection failure #%u (hour %d score %d) - next attempt in %d min",
+             s_state.consecutive_failures, hour, hour >= 0 ? s_state.hour_score[hour] : 0, interval_s / 60);
+}
@@ -175,11 +175,11 @@ void check_and_report_crash(void)
         }
 
         // Disconnect Wi-Fi to allow the main application logic to manage power
-        esp_wifi_disconnect();
-        esp_wifi_stop();
+        wifi_manager_stop();
         ESP_LOGI(TAG, "Wi-Fi disconnected after sending report.");
     } else {
         ESP_LOGE(TAG, "Failed to connect to Wi-Fi to send %s log report.", prefix);
+        wifi_manager_stop();
     }
 
     // Free allocated memory
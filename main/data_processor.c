@@ -11,17 +11,26 @@
  */
 
 #include "data_processor.h"
+#include "duty_cycle.h"
 #include "app_config.h"
 #include "api_client.h"
+#include "adc_battery.h"
 #include "persistent_storage.h"
+#include "send_schedule.h"
+#include "swinging_door.h"
+#include "ntp.h"
+#include "time_utils.h"
+#include "esp_timer.h"
 #include "esp_log.h"
+#include "esp_random.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #define TAG "DATA_PROCESSOR"
 #define MAX_HTTP_RETRY_ATTEMPTS 3
-#define HTTP_RETRY_DELAY_MS 5000
+#define BACKFILL_MAX_BATCHES_PER_CYCLE 6
+#define BACKFILL_TIME_BUDGET_US (20 * 1000000LL)   // Started batches always finish
 
 /**
  * @brief Create a filtered copy of sensor readings with valid timestamps only
@@ -77,6 +86,73 @@ static sensor_reading_t* create_filtered_readings(const sensor_reading_t* origin
     return filtered;
 }
 
+/**
+ * @brief Give provisional readings real timestamps once the clock is valid
+ *
+ * Readings from this boot are rebased from their esp_timer timestamp. Readings
+ * that are still provisional but belong to this boot are moved to the end of
+ * the array so the caller can hold them back until the clock is set; the
+ * order of the rest is preserved.
+ *
+ * @return Number of readings at the front of the array that are ready to send
+ */
+static int rebase_provisional_readings(sensor_reading_t* readings, int count) {
+    bool clock_valid = is_system_time_valid();
+    uint32_t boot_id = time_utils_get_boot_id();
+    int64_t now_mono_us = esp_timer_get_time();
+    time_t now = time(NULL);
+    int rebased = 0;
+    int ready = 0;
+    int held = 0;
+
+    sensor_reading_t *held_readings = NULL;
+    for (int i = 0; i < count; i++) {
+        sensor_reading_t reading = readings[i];
+        if (reading.provisional && reading.boot_id == boot_id) {
+            if (clock_valid) {
+                reading.timestamp = now - (time_t)((now_mono_us - reading.mono_us) / 1000000);
+                reading.provisional = false;
+                rebased++;
+            } else {
+                if (held_readings == NULL) {
+                    held_readings = malloc(count * sizeof(sensor_reading_t));
+                    if (held_readings == NULL) {
+                        ESP_LOGE(TAG, "Failed to allocate memory for provisional readings");
+                        return count;
+                    }
+                }
+                held_readings[held++] = reading;
+                continue;
+            }
+        }
+        readings[ready++] = reading;
+    }
+
+    if (held > 0) {
+        memcpy(readings + ready, held_readings, held * sizeof(sensor_reading_t));
+        ESP_LOGI(TAG, "Holding %d provisional readings until the clock is set", held);
+    }
+    free(held_readings);
+
+    if (rebased > 0) {
+        ESP_LOGI(TAG, "Rebased %d provisional readings to wall-clock time", rebased);
+    }
+    return ready;
+}
+
+/**
+ * @brief Keep provisional readings in storage until they can be rebased
+ */
+static void hold_provisional_readings(const sensor_reading_t* readings, int count) {
+    if (count <= 0) {
+        return;
+    }
+    esp_err_t err = persistent_storage_save_readings(readings, count);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store %d provisional readings: %s", count, esp_err_to_name(err));
+    }
+}
+
 bool data_processor_init(void) {
     esp_err_t err = persistent_storage_init();
     if (err != ESP_OK) {
@@ -95,6 +171,32 @@ bool data_processor_init(void) {
     return true;
 }
 
+void apply_pending_time_correction(app_context_t *context) {
+    time_correction_t correction;
+    if (!ntp_take_time_correction(&correction)) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Correcting timestamps since %lld by up to %lld ms",
+             (long long)correction.window_start, correction.offset_us / 1000);
+
+    int buffered_changed = 0;
+    if (xSemaphoreTake(context->buffer_mutex, portMAX_DELAY) == pdTRUE) {
+        buffered_changed = persistent_storage_correct_timestamps(
+            context->reading_buffer, *(context->reading_idx), &correction);
+        xSemaphoreGive(context->buffer_mutex);
+    }
+    buffered_changed += duty_cycle_correct_timestamps(&correction);
+    if (buffered_changed > 0) {
+        ESP_LOGI(TAG, "Corrected %d buffered readings", buffered_changed);
+    }
+
+    esp_err_t err = persistent_storage_apply_time_correction(&correction);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to correct stored readings: %s", esp_err_to_name(err));
+    }
+}
+
 bool process_buffered_readings(app_context_t *context, bool (*processor)(sensor_reading_t*, int)) {
     sensor_reading_t *temp_buffer = malloc(context->buffer_size * sizeof(sensor_reading_t));
     if (temp_buffer == NULL) {
@@ -123,9 +225,14 @@ bool process_buffered_readings(app_context_t *context, bool (*processor)(sensor_
     return success;
 }
 
-bool send_readings_processor(sensor_reading_t* readings, int count) {
-    ESP_LOGI(TAG, "Sending %d batched readings.", count);
-
+/**
+ * @brief Filter, compress and send readings whose timestamps are final
+ *
+ * @param readings Readings to send, not modified
+ * @param count Number of readings
+ * @return true if sent, or if none were left to send after filtering
+ */
+static bool send_ready_readings(sensor_reading_t* readings, int count) {
     // Create filtered readings
     int filtered_count;
     sensor_reading_t* filtered_readings = create_filtered_readings(readings, count, &filtered_count);
@@ -136,6 +243,13 @@ bool send_readings_processor(sensor_reading_t* readings, int count) {
         return true; // No valid readings is considered success
     }
 
+#if CONFIG_COMPRESSION_MAX_ERROR_LUX > 0
+    int uncompressed_count = filtered_count;
+    filtered_count = swinging_door_compress(filtered_readings, filtered_count, CONFIG_COMPRESSION_MAX_ERROR_LUX);
+    ESP_LOGI(TAG, "Compressed %d readings to %d (max error %d lx)",
+             uncompressed_count, filtered_count, CONFIG_COMPRESSION_MAX_ERROR_LUX);
+#endif
+
     bool success = false;
     for (int attempt = 1; attempt <= MAX_HTTP_RETRY_ATTEMPTS; attempt++) {
         ESP_LOGI(TAG, "Sensor data send attempt %d/%d (%d filtered readings)",
@@ -157,8 +271,9 @@ bool send_readings_processor(sensor_reading_t* readings, int count) {
         }
 
         if (attempt < MAX_HTTP_RETRY_ATTEMPTS) {
-            ESP_LOGI(TAG, "Waiting %d ms before retry...", HTTP_RETRY_DELAY_MS);
-            vTaskDelay(pdMS_TO_TICKS(HTTP_RETRY_DELAY_MS));
+            uint32_t delay_ms = send_schedule_retry_delay_ms(attempt, esp_random);
+            ESP_LOGI(TAG, "Waiting %lu ms before retry...", (unsigned long)delay_ms);
+            vTaskDelay(pdMS_TO_TICKS(delay_ms));
         }
     }
 
@@ -171,8 +286,36 @@ bool send_readings_processor(sensor_reading_t* readings, int count) {
     return success;
 }
 
+bool send_readings_processor(sensor_reading_t* readings, int count) {
+    ESP_LOGI(TAG, "Sending %d batched readings.", count);
+
+    int ready = rebase_provisional_readings(readings, count);
+    hold_provisional_readings(readings + ready, count - ready);
+    return send_ready_readings(readings, ready);
+}
+
+bool send_or_save_readings_processor(sensor_reading_t* readings, int count) {
+    ESP_LOGI(TAG, "Sending %d batched readings.", count);
+
+    int ready = rebase_provisional_readings(readings, count);
+    hold_provisional_readings(readings + ready, count - ready);
+    if (send_ready_readings(readings, ready)) {
+        return true;
+    }
+
+    // The buffer was already emptied for this send; keep the readings for backfill
+    if (save_readings_processor(readings, ready)) {
+        ESP_LOGW(TAG, "Saved %d unsent readings to persistent storage", ready);
+    } else {
+        ESP_LOGE(TAG, "Could not send or save %d readings - they are lost", ready);
+    }
+    return false;
+}
+
 bool save_readings_processor(sensor_reading_t* readings, int count) {
     ESP_LOGI(TAG, "Saving %d readings to persistent storage due to WiFi failure", count);
+    // Rebase now if the clock became valid; the esp_timer base is lost on reboot
+    rebase_provisional_readings(readings, count);
     esp_err_t storage_err = persistent_storage_save_readings(readings, count);
     if (storage_err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to save readings to persistent storage: %s", esp_err_to_name(storage_err));
@@ -183,60 +326,100 @@ bool save_readings_processor(sensor_reading_t* readings, int count) {
     }
 }
 
-bool send_all_stored_readings(void) {
-    // Check if we have any stored readings first
+bool has_stored_readings(void) {
     int stored_count = 0;
-    esp_err_t err = persistent_storage_get_count(&stored_count);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to get stored reading count: %s", esp_err_to_name(err));
-        return false;
-    }
+    return persistent_storage_get_count(&stored_count) == ESP_OK && stored_count > 0;
+}
+
+/**
+ * @brief Check whether the battery is too low to spend energy on old readings
+ */
+static bool battery_too_low_for_backfill(void) {
+    float voltage = 0;
+    return adc_battery_is_present() && adc_battery_get_voltage(&voltage) == ESP_OK &&
+           voltage <= BATTERY_LOW_THRESHOLD_V;
+}
 
-    if (stored_count == 0) {
-        ESP_LOGI(TAG, "No stored readings to send");
+bool backfill_stored_readings(void) {
+    if (!is_system_time_valid()) {
+        ESP_LOGI(TAG, "Clock not set - leaving stored readings for a later cycle");
         return true;
     }
-
-    // Allocate memory for stored readings
-    sensor_reading_t *stored_readings = malloc(PERSISTENT_STORAGE_MAX_READINGS * sizeof(sensor_reading_t));
-    if (stored_readings == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate memory for stored readings");
-        return false;
+    if (battery_too_low_for_backfill()) {
+        ESP_LOGI(TAG, "Battery low - leaving stored readings for a later cycle");
+        return true;
     }
 
-    // Load stored readings
-    int loaded_count = 0;
-    err = persistent_storage_load_readings(stored_readings, PERSISTENT_STORAGE_MAX_READINGS, &loaded_count);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to load stored readings: %s", esp_err_to_name(err));
-        free(stored_readings);
-        return false;
-    }
+    int64_t started_us = esp_timer_get_time();
+    int batches_sent = 0;
+    bool success = true;
 
-    if (loaded_count == 0) {
-        ESP_LOGI(TAG, "No stored readings loaded");
-        free(stored_readings);
-        return true;
-    }
+    while (batches_sent < BACKFILL_MAX_BATCHES_PER_CYCLE &&
+           esp_timer_get_time() - started_us < BACKFILL_TIME_BUDGET_US) {
+        // Size the newest batch first; batches are usually a few dozen readings,
+        // far below the storage limit
+        int batch_count = 0;
+        int batch_index = -1;
+        esp_err_t err = persistent_storage_load_newest_batch(NULL, 0, &batch_count, &batch_index);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to size stored readings: %s", esp_err_to_name(err));
+            success = false;
+            break;
+        }
+        if (batch_index < 0) {
+            break;      // Nothing left
+        }
+        if (batch_count > PERSISTENT_STORAGE_MAX_READINGS) {
+            ESP_LOGW(TAG, "Dropping stored batch %d that is too large to send", batch_index);
+            persistent_storage_remove_batch(batch_index);
+            continue;
+        }
 
-    ESP_LOGI(TAG, "Attempting to send %d stored readings", loaded_count);
+        sensor_reading_t *batch = NULL;
+        int loaded_count = 0;
+        if (batch_count > 0) {
+            batch = malloc(batch_count * sizeof(sensor_reading_t));
+            if (batch == NULL) {
+                ESP_LOGE(TAG, "Failed to allocate memory for %d stored readings", batch_count);
+                success = false;
+                break;
+            }
+            err = persistent_storage_load_newest_batch(batch, batch_count, &loaded_count, &batch_index);
+            if (err == ESP_ERR_INVALID_SIZE) {
+                // A larger batch was saved since the size query; size again
+                free(batch);
+                continue;
+            }
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to load stored readings: %s", esp_err_to_name(err));
+                free(batch);
+                success = false;
+                break;
+            }
+        }
 
-    // Send the stored readings
-    bool send_success = send_readings_processor(stored_readings, loaded_count);
+        // The clock is valid, so no readings are held back and re-saved during the send
+        bool sent = loaded_count == 0 || send_readings_processor(batch, loaded_count);
+        free(batch);
+        if (!sent) {
+            ESP_LOGE(TAG, "Failed to send stored batch %d", batch_index);
+            success = false;
+            break;
+        }
 
-    if (send_success) {
-        // Clear stored readings after successful send
-        err = persistent_storage_clear_readings();
+        err = persistent_storage_remove_batch(batch_index);
         if (err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to clear stored readings after send: %s", esp_err_to_name(err));
-            free(stored_readings);
-            return false;
+            ESP_LOGE(TAG, "Failed to remove stored batch %d after send: %s", batch_index, esp_err_to_name(err));
+            success = false;
+            break;
         }
-        ESP_LOGI(TAG, "Successfully sent and cleared %d stored readings", loaded_count);
-    } else {
-        ESP_LOGE(TAG, "Failed to send stored readings");
+        batches_sent++;
     }
 
-    free(stored_readings);
-    return send_success;
-}
\ No newline at end of file
+    int remaining = 0;
+    persistent_storage_get_count(&remaining);
+    ESP_LOGI(TAG, "Backfilled %d stored batches in %lld ms, %d readings left",
+             batches_sent, (long long)((esp_timer_get_time() - started_us) / 1000), remaining);
+
+    return success;
+}
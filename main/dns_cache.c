@@ -0,0 +1,145 @@
+/**
+* @file dns_cache.c
+ *
+ * RTC-memory cache of the API host address so DNS survives WiFi power cycles.
+ *
+ * disconnect_wifi_for_power_saving() stops the WiFi driver every cycle, which
+ * loses lwIP's DNS table. This keeps the resolved address of the CONFIG_API_URL
+ * host in RTC memory with a fixed TTL and answers lookups for it through the
+ * lwIP netconn external-resolve hook (CONFIG_LWIP_HOOK_NETCONN_EXT_RESOLVE_CUSTOM),
+ * so esp-tls skips the DNS round trip. The entry is dropped when a connection
+ * fails so a moved server is picked up on the next attempt.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "dns_cache.h"
+#include "app_config.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "lwip/api.h"
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+#include "lwip/netdb.h"
+#include <string.h>
+#include <time.h>
+
+#define TAG "DNS_CACHE"
+
+#define DNS_CACHE_TTL_S (6 * 60 * 60)   // Re-resolve at least every 6 hours
+#define DNS_CACHE_HOST_MAX 64
+
+/**
+ * @brief Cached API host address, kept in RTC memory so it survives deep sleep
+ */
+typedef struct {
+    char host[DNS_CACHE_HOST_MAX];
+    uint32_t addr;          // IPv4, network byte order
+    time_t resolved_at;
+    bool valid;
+} dns_cache_entry_t;
+
+static RTC_DATA_ATTR dns_cache_entry_t s_entry;
+
+/**
+ * @brief Extract the host part of CONFIG_API_URL ("https://host:port/path" -> "host")
+ */
+static bool get_api_host(char *host, size_t host_size) {
+    const char *start = strstr(CONFIG_API_URL, "://");
+    start = (start != NULL) ? start + 3 : CONFIG_API_URL;
+
+    size_t len = strcspn(start, ":/?");
+    if (len == 0 || len >= host_size) {
+        return false;
+    }
+    memcpy(host, start, len);
+    host[len] = '\0';
+    return true;
+}
+
+static bool is_entry_fresh(void) {
+    if (!s_entry.valid) {
+        return false;
+    }
+    time_t now = time(NULL);
+    // A clock that moved backwards (e.g. cold boot before NTP) also expires the entry
+    return now >= s_entry.resolved_at && (now - s_entry.resolved_at) < DNS_CACHE_TTL_S;
+}
+
+bool dns_cache_lookup(const char *name, uint32_t *addr) {
+    if (name == NULL || addr == NULL || !is_entry_fresh()) {
+        return false;
+    }
+    if (strcmp(name, s_entry.host) != 0) {
+        return false;
+    }
+    *addr = s_entry.addr;
+    return true;
+}
+
+void dns_cache_refresh(void) {
+    if (is_entry_fresh()) {
+        return;
+    }
+
+    char host[DNS_CACHE_HOST_MAX];
+    if (!get_api_host(host, sizeof(host))) {
+        ESP_LOGW(TAG, "Could not parse host from API URL");
+        return;
+    }
+
+    // Answered from lwIP's own DNS table, populated by the request that just finished
+    struct addrinfo hints = { .ai_family = AF_INET, .ai_socktype = SOCK_STREAM };
+    struct addrinfo *result = NULL;
+    int err = getaddrinfo(host, NULL, &hints, &result);
+    if (err != 0 || result == NULL) {
+        ESP_LOGW(TAG, "Failed to resolve %s for cache (err=%d)", host, err);
+        return;
+    }
+
+    struct sockaddr_in *sin = (struct sockaddr_in *)result->ai_addr;
+    strncpy(s_entry.host, host, sizeof(s_entry.host) - 1);
+    s_entry.host[sizeof(s_entry.host) - 1] = '\0';
+    s_entry.addr = sin->sin_addr.s_addr;
+    s_entry.resolved_at = time(NULL);
+    s_entry.valid = true;
+    freeaddrinfo(result);
+
+    ip4_addr_t ip = { .addr = s_entry.addr };
+    ESP_LOGI(TAG, "Cached %s -> " IPSTR " for %d s", s_entry.host, IP2STR(&ip), DNS_CACHE_TTL_S);
+}
+
+void dns_cache_invalidate(void) {
+    if (s_entry.valid) {
+        ESP_LOGI(TAG, "Invalidating cached address for %s", s_entry.host);
+    }
+    s_entry.valid = false;
+}
+
+/**
+ * @brief lwIP netconn external-resolve hook
+ *
+ * Called by netconn_gethostbyname() before the normal DNS path.
+ *
+ * @return 1 if the name was answered from the cache, 0 to fall through to DNS
+ */
+int lwip_hook_netconn_external_resolve(const char *name, ip_addr_t *addr, u8_t addrtype, err_t *err) {
+    if (addrtype == NETCONN_DNS_IPV6) {
+        return 0;
+    }
+
+    uint32_t cached;
+    if (!dns_cache_lookup(name, &cached)) {
+        return 0;
+    }
+
+    ip_addr_set_ip4_u32(addr, cached);
+    *err = ERR_OK;
+    ESP_LOGD(TAG, "Resolved %s from cache", name);
+    return 1;
+}
@@ -0,0 +1,301 @@
+/**
+* @file duty_cycle.c
+ *
+ * Daytime deep sleep between samples for battery-powered sensors.
+ *
+ * Instead of staying awake all day to take a reading every 15 seconds, the
+ * device deep sleeps between samples. Each timer wake takes one reading into
+ * a buffer in RTC memory, which survives deep sleep, and goes straight back
+ * to sleep. Only when this device's next send time comes round (see
+ * send_schedule) or the buffer is nearly full does the wake continue into a
+ * full boot, which brings up WiFi, uploads the buffer and sleeps again.
+ *
+ * Sample wakes are handled at the very top of app_main, before NVS, log
+ * capture, the crash check and ADC setup, with a one-time BH1750 measurement.
+ * An RTC wake stub would start sooner, but it cannot use the I2C driver and
+ * would have to wait out the 120+ ms measurement anyway. Awake time for both
+ * kinds of wake is tracked in RTC memory and logged at each upload.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "duty_cycle.h"
+#include "app_config.h"
+#include "adc_battery.h"
+#include "data_processor.h"
+#include "internal_temp.h"
+#include "light_sensor.h"
+#include "lux_stats.h"
+#include "ntp.h"
+#include "persistent_storage.h"
+#include "sampling_scheduler.h"
+#include "send_schedule.h"
+#include "time_utils.h"
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_random.h"
+#include <string.h>
+#include <time.h>
+
+#define TAG "DUTY_CYCLE"
+
+#define DUTY_CYCLE_SAMPLE_INTERVAL_S 15
+#define DUTY_CYCLE_SEND_INTERVAL_S (5 * 60)
+#define DUTY_CYCLE_BATCH_SIZE (DUTY_CYCLE_SEND_INTERVAL_S / DUTY_CYCLE_SAMPLE_INTERVAL_S)
+#define DUTY_CYCLE_RING_SIZE (DUTY_CYCLE_BATCH_SIZE * 2)    // Headroom if a boot is cut short
+#define DUTY_CYCLE_MIN_SLEEP_US 1000000ULL
+
+/**
+ * @brief Readings taken while sleeping between samples, kept in RTC memory
+ */
+typedef struct {
+    bool active;                // Sleeping between samples; cleared on every wake
+    time_t next_upload;         // Wall time of the next upload, on this device's send phase
+    int head;                   // Index of the oldest reading
+    int count;
+    sensor_reading_t readings[DUTY_CYCLE_RING_SIZE];
+} duty_cycle_state_t;
+
+/**
+ * @brief App start to deep sleep time for each kind of wake, since the last upload
+ */
+typedef struct {
+    uint32_t sample_wakes;
+    uint64_t sample_total_us;
+    uint32_t sample_max_us;
+    uint32_t upload_wakes;
+    uint64_t upload_total_us;
+    uint32_t upload_max_us;
+} duty_cycle_timing_t;
+
+static RTC_DATA_ATTR duty_cycle_state_t s_state;
+static RTC_DATA_ATTR duty_cycle_timing_t s_timing;
+static bool s_upload_wake = false;
+
+static void ring_push(const sensor_reading_t *reading) {
+    int tail = (s_state.head + s_state.count) % DUTY_CYCLE_RING_SIZE;
+    s_state.readings[tail] = *reading;
+    if (s_state.count < DUTY_CYCLE_RING_SIZE) {
+        s_state.count++;
+    } else {
+        // Full: drop the oldest
+        s_state.head = (s_state.head + 1) % DUTY_CYCLE_RING_SIZE;
+    }
+}
+
+/**
+ * @brief Copy the buffered readings out oldest first
+ */
+static int ring_copy(sensor_reading_t *out) {
+    for (int i = 0; i < s_state.count; i++) {
+        out[i] = s_state.readings[(s_state.head + i) % DUTY_CYCLE_RING_SIZE];
+    }
+    return s_state.count;
+}
+
+static void ring_clear(void) {
+    s_state.head = 0;
+    s_state.count = 0;
+}
+
+static void record_awake_time(bool sample_wake, uint64_t awake_us) {
+    uint32_t us = awake_us > UINT32_MAX ? UINT32_MAX : (uint32_t)awake_us;
+    if (sample_wake) {
+        s_timing.sample_wakes++;
+        s_timing.sample_total_us += us;
+        if (us > s_timing.sample_max_us) {
+            s_timing.sample_max_us = us;
+        }
+    } else {
+        s_timing.upload_wakes++;
+        s_timing.upload_total_us += us;
+        if (us > s_timing.upload_max_us) {
+            s_timing.upload_max_us = us;
+        }
+    }
+}
+
+/**
+ * @brief Log the awake time of both kinds of wake and start a new period
+ */
+static void log_wake_timing(void) {
+    if (s_timing.sample_wakes > 0) {
+        ESP_LOGI(TAG, "Sample wakes: %lu, avg %llu ms, max %lu ms",
+                 (unsigned long)s_timing.sample_wakes,
+                 s_timing.sample_total_us / s_timing.sample_wakes / 1000,
+                 (unsigned long)(s_timing.sample_max_us / 1000));
+    }
+    if (s_timing.upload_wakes > 0) {
+        ESP_LOGI(TAG, "Upload boots: %lu, avg %llu ms, max %lu ms",
+                 (unsigned long)s_timing.upload_wakes,
+                 s_timing.upload_total_us / s_timing.upload_wakes / 1000,
+                 (unsigned long)(s_timing.upload_max_us / 1000));
+    }
+    memset(&s_timing, 0, sizeof(s_timing));
+}
+
+/**
+ * @brief Deep sleep until the next sample is due
+ *
+ * @param sample_wake Whether this wake only took a sample, for the timing stats
+ */
+static void sleep_until_next_sample(bool sample_wake) {
+    uint64_t awake_us = (uint64_t)esp_timer_get_time();
+    record_awake_time(sample_wake, awake_us);
+
+    // Wake on the next wall-clock boundary, the same ones the sensor task samples on
+    int64_t now_ms = sampling_scheduler_now_ms();
+    int64_t wake_ms = sampling_scheduler_next_boundary_ms(now_ms, DUTY_CYCLE_SAMPLE_INTERVAL_S * 1000);
+    uint64_t sleep_us = (uint64_t)(wake_ms - now_ms) * 1000ULL;
+    if (sleep_us < DUTY_CYCLE_MIN_SLEEP_US) {
+        sleep_us += DUTY_CYCLE_SAMPLE_INTERVAL_S * 1000000ULL;
+    }
+
+    s_state.active = true;
+    esp_sleep_enable_timer_wakeup(sleep_us);
+    esp_deep_sleep_start();
+}
+
+/**
+ * @brief Take one reading into the RTC buffer
+ */
+static bool take_sample(void) {
+    sensor_reading_t reading = { 0 };
+
+    // One sample per wake; sub-sampling would multiply the wakes
+    float lux;
+    esp_err_t light_err = read_ambient_light_once(&lux);
+    if (light_err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to get light reading: %s", esp_err_to_name(light_err));
+        return false;
+    }
+    time_utils_observe_lux(lux);
+
+    lux_stats_t stats;
+    lux_stats_reset(&stats);
+    lux_stats_add(&stats, lux, DUTY_CYCLE_SAMPLE_INTERVAL_S);
+    lux_stats_to_reading(&stats, &reading);
+
+    float chip_temp_c;
+    if (internal_temp_init() == ESP_OK && internal_temp_read(&chip_temp_c) == ESP_OK) {
+        reading.chip_temp_c = chip_temp_c;
+        reading.chip_temp_f = (chip_temp_c * 9.0f / 5.0f) + 32.0f;
+    } else {
+        reading.chip_temp_c = -999.0f;
+        reading.chip_temp_f = -999.0f;
+    }
+
+    time(&reading.timestamp);
+    reading.mono_us = esp_timer_get_time();
+    reading.boot_id = time_utils_get_boot_id();
+    reading.provisional = false;    // Sleep is only armed with a valid clock
+
+    ring_push(&reading);
+    ESP_LOGI(TAG, "Sample %d buffered (Lux: %.2f)", s_state.count, reading.lux);
+    return true;
+}
+
+bool duty_cycle_is_enabled(void) {
+#if !CONFIG_DAYTIME_DEEP_SLEEP || !CONFIG_IDF_TARGET_ESP32C3
+    return false;
+#else
+    return adc_battery_is_present();
+#endif
+}
+
+void duty_cycle_handle_wake(void) {
+    bool was_active = s_state.active;
+    s_state.active = false;     // Anything but a clean re-sleep below ends up in a full boot
+
+    if (!was_active || esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) {
+        return;
+    }
+
+    if (!is_system_time_valid() || is_nighttime_local()) {
+        ESP_LOGI(TAG, "Cannot sample while sleeping right now - doing a full boot");
+        s_upload_wake = true;
+        return;
+    }
+
+    take_sample();
+
+    time_t now = time(NULL);
+    // The send phase normally triggers first; a nearly full ring uploads regardless
+    if (s_state.count >= DUTY_CYCLE_RING_SIZE - 1 || now >= s_state.next_upload) {
+        ESP_LOGI(TAG, "Upload due (%d readings buffered)", s_state.count);
+        s_upload_wake = true;
+        return;
+    }
+
+    sleep_until_next_sample(true);
+}
+
+bool duty_cycle_is_upload_wake(void) {
+    return s_upload_wake;
+}
+
+void duty_cycle_flush_readings(bool connected) {
+    if (s_state.count == 0) {
+        return;
+    }
+
+    static sensor_reading_t readings[DUTY_CYCLE_RING_SIZE];
+    int count = ring_copy(readings);
+
+    if (connected && send_readings_processor(readings, count)) {
+        ESP_LOGI(TAG, "Sent %d readings taken while sleeping", count);
+        ring_clear();
+    } else if (save_readings_processor(readings, count)) {
+        ESP_LOGW(TAG, "Saved %d readings taken while sleeping to persistent storage", count);
+        ring_clear();
+    } else {
+        ESP_LOGE(TAG, "Could not send or save %d buffered readings, keeping them in RTC memory", count);
+    }
+}
+
+int duty_cycle_correct_timestamps(const time_correction_t *correction) {
+    int changed = 0;
+    for (int i = 0; i < s_state.count; i++) {
+        sensor_reading_t *reading = &s_state.readings[(s_state.head + i) % DUTY_CYCLE_RING_SIZE];
+        changed += persistent_storage_correct_timestamps(reading, 1, correction);
+    }
+    return changed;
+}
+
+void duty_cycle_sleep_if_enabled(app_context_t *context) {
+    if (!duty_cycle_is_enabled() || !is_system_time_valid() || is_nighttime_local()) {
+        return;
+    }
+
+    // Hand over anything the sensor task collected while we were awake.
+    // Provisional readings need this boot's ID to be rebased, and the ring must
+    // not overwrite anything, so those readings go to storage instead.
+    if (xSemaphoreTake(context->buffer_mutex, portMAX_DELAY) == pdTRUE) {
+        int kept = 0;
+        for (int i = 0; i < *(context->reading_idx); i++) {
+            if (context->reading_buffer[i].provisional || s_state.count >= DUTY_CYCLE_RING_SIZE) {
+                context->reading_buffer[kept++] = context->reading_buffer[i];
+            } else {
+                ring_push(&context->reading_buffer[i]);
+            }
+        }
+        *(context->reading_idx) = kept;
+        xSemaphoreGive(context->buffer_mutex);
+    }
+    if (*(context->reading_idx) > 0) {
+        process_buffered_readings(context, save_readings_processor);
+    }
+
+    s_state.next_upload = send_schedule_next_send_time(CONFIG_SENSOR_ID, time(NULL), DUTY_CYCLE_SEND_INTERVAL_S,
+                                                       esp_random);
+    log_wake_timing();
+    ESP_LOGI(TAG, "Sleeping between samples (%d s interval, upload every %d s)",
+             DUTY_CYCLE_SAMPLE_INTERVAL_S, DUTY_CYCLE_SEND_INTERVAL_S);
+    sleep_until_next_sample(false);
+}
@@ -12,6 +12,9 @@
 
 #include "http_client.h"
 #include "app_config.h"
+#include "dns_cache.h"
+#include "http_time.h"
+#include "pm_control.h"
 #include "esp_http_client.h"
 #include "esp_log.h"
 #include <string.h>
@@ -35,9 +38,11 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
         break;
     case HTTP_EVENT_HEADER_SENT:
         ESP_LOGD(TAG, "HTTP_EVENT_HEADER_SENT");
+        http_time_request_start();
         break;
     case HTTP_EVENT_ON_HEADER:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_HEADER, key=%s, value=%s", evt->header_key, evt->header_value);
+        http_time_on_header(evt->header_key, evt->header_value);
         break;
     case HTTP_EVENT_ON_DATA:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_DATA, len=%d", evt->data_len);
@@ -122,7 +127,10 @@ esp_err_t http_send_json_payload(const char* json_payload, const char* bearer_to
 
     // Perform the HTTP request
     ESP_LOGI(TAG, "Performing HTTP request (timeout: 30s)");
+    pm_control_acquire(PM_LOCK_HTTP);
     err = esp_http_client_perform(client);
+    pm_control_release(PM_LOCK_HTTP);
+    http_time_request_end(err == ESP_OK);
     if (err == ESP_OK) {
         int status_code = esp_http_client_get_status_code(client);
         int content_length = esp_http_client_get_content_length(client);
@@ -158,8 +166,12 @@ esp_err_t http_send_json_payload(const char* json_payload, const char* bearer_to
                     break;
             }
         }
+        // The server answered, so the address is good for another TTL
+        dns_cache_refresh();
     } else {
         ESP_LOGE(TAG, "HTTPS POST request failed: %s", esp_err_to_name(err));
+        // Re-resolve on the next attempt in case the cached address went stale
+        dns_cache_invalidate();
     }
 
     esp_http_client_cleanup(client);
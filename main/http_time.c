@@ -0,0 +1,167 @@
+/**
+* @file http_time.c
+ *
+ * Wall-clock time taken from API response headers.
+ *
+ * Every upload is already an HTTPS round trip to our own server, so its Date
+ * header gives the time without a separate SNTP exchange. The server time is
+ * moved forward by half the round trip, measured from sending the request
+ * headers to receiving the response headers. Date only has 1 s resolution,
+ * so an optional header carrying epoch milliseconds is used when present.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "http_time.h"
+#include "app_config.h"
+#include "ntp.h"
+#include "tz_table.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <time.h>
+
+#define TAG "HTTP_TIME"
+
+#define DATE_RESOLUTION_US 1000000LL    // Date header truncates to whole seconds
+
+/**
+ * @brief One server time measurement
+ */
+typedef struct {
+    bool valid;
+    int64_t offset_us;          // Server time minus local clock
+    int64_t uncertainty_us;     // Half the round trip plus header resolution
+    int64_t taken_at_us;        // esp_timer time of the measurement
+} http_time_sample_t;
+
+static http_time_sample_t s_sample;
+
+// Per-request state
+static int64_t s_request_sent_us = 0;
+static int64_t s_response_us = 0;       // esp_timer when the time header arrived
+static int64_t s_response_wall_us = 0;  // Local wall clock at the same instant
+static int64_t s_server_us = 0;         // Server time from the header, 0 if none
+static int64_t s_server_resolution_us = 0;
+
+static int64_t wall_clock_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+/**
+ * @brief Parse an RFC 1123 date such as "Sun, 06 Nov 1994 08:49:37 GMT"
+ */
+static bool parse_http_date(const char *value, time_t *out) {
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char month_name[4] = { 0 };
+    int day, year, hour, minute, second;
+
+    if (sscanf(value, "%*3s, %d %3s %d %d:%d:%d GMT",
+               &day, month_name, &year, &hour, &minute, &second) != 6) {
+        return false;
+    }
+    const char *match = strstr(months, month_name);
+    if (match == NULL || strlen(month_name) != 3 || (match - months) % 3 != 0) {
+        return false;
+    }
+    int month = (int)(match - months) / 3 + 1;
+    if (day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    *out = (time_t)(tz_table_days_from_civil(year, month, day) * 86400LL + hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+void http_time_request_start(void) {
+    s_request_sent_us = esp_timer_get_time();
+    s_server_us = 0;
+    s_server_resolution_us = 0;
+}
+
+void http_time_on_header(const char *key, const char *value) {
+#if CONFIG_HTTP_TIME_SOURCE
+    if (key == NULL || value == NULL || s_request_sent_us == 0) {
+        return;
+    }
+
+    if (strlen(CONFIG_HTTP_TIME_HEADER) > 0 && strcasecmp(key, CONFIG_HTTP_TIME_HEADER) == 0) {
+        char *end = NULL;
+        long long ms = strtoll(value, &end, 10);
+        if (end != value && ms > 0) {
+            s_response_us = esp_timer_get_time();
+            s_response_wall_us = wall_clock_us();
+            s_server_us = ms * 1000LL;
+            s_server_resolution_us = 1000;
+        }
+    } else if (strcasecmp(key, "Date") == 0 && s_server_resolution_us != 1000) {
+        time_t date;
+        if (parse_http_date(value, &date)) {
+            s_response_us = esp_timer_get_time();
+            s_response_wall_us = wall_clock_us();
+            // Middle of the truncated second
+            s_server_us = (int64_t)date * 1000000LL + DATE_RESOLUTION_US / 2;
+            s_server_resolution_us = DATE_RESOLUTION_US;
+        }
+    }
+#endif
+}
+
+void http_time_request_end(bool server_answered) {
+    if (server_answered && s_server_us > 0 && s_request_sent_us > 0) {
+        int64_t half_rtt_us = (s_response_us - s_request_sent_us) / 2;
+        s_sample.offset_us = (s_server_us + half_rtt_us) - s_response_wall_us;
+        s_sample.uncertainty_us = half_rtt_us + s_server_resolution_us / 2;
+        s_sample.taken_at_us = s_response_us;
+        s_sample.valid = true;
+        ESP_LOGD(TAG, "Server time sample: offset %lld ms, +/- %lld ms",
+                 s_sample.offset_us / 1000, s_sample.uncertainty_us / 1000);
+    }
+    s_request_sent_us = 0;
+    s_server_us = 0;
+    s_server_resolution_us = 0;
+}
+
+bool http_time_apply(uint32_t max_age_s, int64_t *offset_us) {
+    if (!s_sample.valid) {
+        return false;
+    }
+    int64_t age_us = esp_timer_get_time() - s_sample.taken_at_us;
+    if (age_us > (int64_t)max_age_s * 1000000LL) {
+        ESP_LOGD(TAG, "Server time sample too old (%lld s)", age_us / 1000000);
+        return false;
+    }
+
+    if (offset_us != NULL) {
+        *offset_us = s_sample.offset_us;
+    }
+
+    if (llabs(s_sample.offset_us) > s_sample.uncertainty_us) {
+        // Same bookkeeping as an SNTP step: stored readings and the drift model follow it
+        if (!ntp_apply_offset(s_sample.offset_us, s_sample.uncertainty_us)) {
+            ESP_LOGE(TAG, "Failed to set time from server response");
+            return false;
+        }
+        ESP_LOGI(TAG, "Clock stepped by %lld ms from server time (+/- %lld ms)",
+                 s_sample.offset_us / 1000, s_sample.uncertainty_us / 1000);
+        // Later corrections are relative to the stepped clock
+        s_sample.offset_us = 0;
+    } else {
+        // Counts as a sync, so it is recorded like one
+        ntp_confirm_offset(s_sample.offset_us, s_sample.uncertainty_us);
+        ESP_LOGI(TAG, "Clock agrees with server time (offset %lld ms, +/- %lld ms)",
+                 s_sample.offset_us / 1000, s_sample.uncertainty_us / 1000);
+        s_sample.offset_us = 0;
+    }
+    return true;
+}
@@ -14,14 +14,36 @@
 #include "app_config.h"
 #include "bh1750.h"
 #include "light_sensor.h"
+#include "lux_range.h"
+#include "pm_control.h"
 #include "i2cdev.h"
 #include <esp_check.h> // Include for ESP_RETURN_ON_ERROR and other check macros
+#include <esp_timer.h>
+#include <esp_attr.h>
 
 #define TAG "LIGHT_SENSOR"
 
+#define ONE_SHOT_MAX_CONVERSION_MS 180  // HIGH2 at the default MTreg; dim light still gets 0.42 lx steps
+
 // Define the sensor descriptor as a static variable in this file
 static i2c_dev_t light_sensor_dev;
 
+// Auto-ranging step, kept across deep sleep so sample wakes start in the right range.
+// The invalid initial step makes lux_range start from its default.
+static RTC_DATA_ATTR lux_range_t s_range = { .step = -1 };
+static lux_range_setting_t s_measuring;     // Configuration of the running measurement
+static uint8_t s_applied_mtreg = 0;         // Measurement time register last written, 0 if unknown
+
+static bh1750_resolution_t to_bh1750_resolution(lux_resolution_t resolution)
+{
+    switch (resolution) {
+        case LUX_RES_LOW:   return BH1750_RES_LOW;
+        case LUX_RES_HIGH2: return BH1750_RES_HIGH2;
+        case LUX_RES_HIGH:
+        default:            return BH1750_RES_HIGH;
+    }
+}
+
 esp_err_t init_light_sensor(i2c_dev_t **dev)
 {
     // Initialize the I2Cdev library. This should be called once per application.
@@ -35,12 +57,12 @@ esp_err_t init_light_sensor(i2c_dev_t **dev)
         "bh1750_init_desc failed"
     );
 
-    // Setup the sensor with continuous high-resolution mode
-    ESP_RETURN_ON_ERROR(
-        bh1750_setup(&light_sensor_dev, BH1750_MODE_CONTINUOUS, BH1750_RES_HIGH),
-        TAG,
-        "bh1750_setup failed"
-    );
+    // Measurements are started one at a time, so keep the sensor powered down until then
+    s_applied_mtreg = 0;
+    pm_control_acquire(PM_LOCK_I2C);
+    esp_err_t setup_err = bh1750_power_down(&light_sensor_dev);
+    pm_control_release(PM_LOCK_I2C);
+    ESP_RETURN_ON_ERROR(setup_err, TAG, "bh1750_power_down failed");
 
     // Pass the address of the static device descriptor back to the caller
     *dev = &light_sensor_dev;
@@ -50,26 +72,111 @@ esp_err_t init_light_sensor(i2c_dev_t **dev)
     return ESP_OK;
 }
 
+esp_err_t start_ambient_light(i2c_dev_t *dev, uint32_t *ready_in_ms)
+{
+    if (dev == NULL || ready_in_ms == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    lux_range_setting_t setting = lux_range_setting(&s_range);
+    esp_err_t result = ESP_OK;
+
+    pm_control_acquire(PM_LOCK_I2C);
+    if (setting.mtreg != s_applied_mtreg) {
+        // The measurement time register is only written while the sensor is powered on
+        result = bh1750_power_on(dev);
+        if (result == ESP_OK) {
+            result = bh1750_set_measurement_time(dev, setting.mtreg);
+        }
+        s_applied_mtreg = (result == ESP_OK) ? setting.mtreg : 0;
+    }
+    if (result == ESP_OK) {
+        result = bh1750_start_measurement(dev, to_bh1750_resolution(setting.resolution));
+    }
+    pm_control_release(PM_LOCK_I2C);
+
+    s_measuring = setting;
+    *ready_in_ms = lux_range_conversion_ms(setting);
+    return result;
+}
+
+void wait_for_ambient_light(int64_t started_us, uint32_t ready_in_ms)
+{
+    int64_t remaining_ms = (int64_t)ready_in_ms - (esp_timer_get_time() - started_us) / 1000;
+    if (remaining_ms > 0) {
+        // One extra tick: vTaskDelay can return up to a tick early
+        vTaskDelay(pdMS_TO_TICKS(remaining_ms) + 1);
+    }
+}
+
 esp_err_t get_ambient_light(i2c_dev_t *dev, float *lux)
 {
     if (dev == NULL || lux == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    uint16_t raw_lux = 0;
-    // The driver reads an unsigned 16-bit integer representing lux
-    esp_err_t result = bh1750_read(dev, &raw_lux);
+    uint16_t raw = 0;
+    pm_control_acquire(PM_LOCK_I2C);
+    esp_err_t result = bh1750_read_raw(dev, &raw);
+    pm_control_release(PM_LOCK_I2C);
 
     if (result != ESP_OK)
     {
         // The calling task will log the error, so we just return it
         return result;
     }
-
-    // The driver returns the value in Lux directly
-    *lux = (float)raw_lux;
+    // Saturated: measure again straight away in less sensitive ranges. Each
+    // retry moves one step, and the least sensitive step never asks again.
+    while (lux_range_update(&s_range, raw)) {
+        ESP_LOGD(TAG, "Light sensor saturated, re-measuring in a wider range");
+        int64_t started_us = esp_timer_get_time();
+        uint32_t ready_in_ms;
+        result = start_ambient_light(dev, &ready_in_ms);
+        if (result == ESP_OK) {
+            wait_for_ambient_light(started_us, ready_in_ms);
+            pm_control_acquire(PM_LOCK_I2C);
+            result = bh1750_read_raw(dev, &raw);
+            pm_control_release(PM_LOCK_I2C);
+        }
+        if (result != ESP_OK) {
+            // The clipped first count is not a valid reading
+            return result;
+        }
+    }
+    *lux = lux_range_to_lux(s_measuring, raw);
 
     // Logging of the value is handled by the calling task for better separation of concerns
     return ESP_OK;
 }
 
+esp_err_t read_ambient_light_once(float *lux)
+{
+    if (lux == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ESP_RETURN_ON_ERROR(i2cdev_init(), TAG, "i2cdev_init failed");
+    ESP_RETURN_ON_ERROR(
+        bh1750_init_desc(&light_sensor_dev, BH1750_ADDR_LO, I2C0_MASTER_PORT, CONFIG_SENSOR_SDA_GPIO, CONFIG_SENSOR_SCL_GPIO),
+        TAG,
+        "bh1750_init_desc failed"
+    );
+    s_applied_mtreg = 0;
+
+    // The most sensitive range takes about 663 ms, which would dominate a sample wake
+    lux_range_limit_conversion(&s_range, ONE_SHOT_MAX_CONVERSION_MS);
+
+    // Starts one measurement; the sensor powers down by itself when it is done
+    int64_t started_us = esp_timer_get_time();
+    uint32_t ready_in_ms;
+    esp_err_t result = start_ambient_light(&light_sensor_dev, &ready_in_ms);
+    if (result == ESP_OK) {
+        wait_for_ambient_light(started_us, ready_in_ms);
+        result = get_ambient_light(&light_sensor_dev, lux);
+    }
+
+    // Release the bus so a later init_light_sensor() starts clean
+    bh1750_free_desc(&light_sensor_dev);
+    i2cdev_done();
+    return result;
+}
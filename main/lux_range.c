@@ -0,0 +1,102 @@
+/**
+* @file lux_range.c
+ *
+ * Auto-ranging for the BH1750: resolution and measurement time chosen from the last reading.
+ *
+ * A fixed high resolution setup counts 0.83 lx per step and saturates at
+ * about 54.6 klx, which cuts off direct sunlight and is coarse at dusk. The
+ * range ladder below runs from HIGH2 mode with the longest measurement time
+ * (about 0.11 lx per count) to LOW mode with the shortest (saturating above
+ * 120 klx). LOW mode's 4 lx steps don't matter in full sun, and it converts in
+ * about 11 ms instead of 80 ms. Each reading picks the step for the next
+ * one. The counts are converted with the datasheet sensitivity of 1.2
+ * counts per lux at MTreg 69.
+ *
+ * This module has no ESP-IDF dependencies.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "lux_range.h"
+
+#define COUNTS_PER_LUX 1.2f             // Datasheet typical sensitivity at MTreg 69
+#define FULL_SCALE_COUNT 65535
+#define STEP_DOWN_COUNT 58982           // 90% of full scale: go less sensitive
+#define STEP_UP_COUNT 32768             // Move more sensitive only if the count would stay under half scale
+#define LOW_RES_MAX_MS 24
+#define HIGH_RES_MAX_MS 180
+
+// Most to least sensitive
+static const lux_range_setting_t s_ladder[] = {
+    { LUX_RES_HIGH2, LUX_RANGE_MTREG_MAX },     // 0.11 lx/count, up to 7.4 klx
+    { LUX_RES_HIGH2, LUX_RANGE_MTREG_DEFAULT }, // 0.42 lx/count, up to 27 klx
+    { LUX_RES_HIGH, LUX_RANGE_MTREG_DEFAULT },  // 0.83 lx/count, up to 54 klx
+    { LUX_RES_LOW, LUX_RANGE_MTREG_MIN },       // 1.9 lx/count, up to 121 klx
+};
+#define LADDER_STEPS ((int)(sizeof(s_ladder) / sizeof(s_ladder[0])))
+#define DEFAULT_STEP 2
+
+/**
+ * @brief Lux represented by one count
+ */
+static float lux_per_count(lux_range_setting_t setting) {
+    float lux = (float)LUX_RANGE_MTREG_DEFAULT / (COUNTS_PER_LUX * setting.mtreg);
+    return setting.resolution == LUX_RES_HIGH2 ? lux / 2.0f : lux;
+}
+
+void lux_range_init(lux_range_t *range) {
+    range->step = DEFAULT_STEP;
+}
+
+lux_range_setting_t lux_range_setting(const lux_range_t *range) {
+    int step = range->step;
+    if (step < 0 || step >= LADDER_STEPS) {
+        step = DEFAULT_STEP;
+    }
+    return s_ladder[step];
+}
+
+uint32_t lux_range_conversion_ms(lux_range_setting_t setting) {
+    uint32_t base_ms = setting.resolution == LUX_RES_LOW ? LOW_RES_MAX_MS : HIGH_RES_MAX_MS;
+    return (base_ms * setting.mtreg + LUX_RANGE_MTREG_DEFAULT - 1) / LUX_RANGE_MTREG_DEFAULT;
+}
+
+void lux_range_limit_conversion(lux_range_t *range, uint32_t max_ms) {
+    if (range->step < 0 || range->step >= LADDER_STEPS) {
+        range->step = DEFAULT_STEP;
+    }
+    while (range->step < LADDER_STEPS - 1 && lux_range_conversion_ms(s_ladder[range->step]) > max_ms) {
+        range->step++;
+    }
+}
+
+float lux_range_to_lux(lux_range_setting_t setting, uint16_t raw) {
+    return (float)raw * lux_per_count(setting);
+}
+
+bool lux_range_update(lux_range_t *range, uint16_t raw) {
+    if (range->step < 0 || range->step >= LADDER_STEPS) {
+        range->step = DEFAULT_STEP;
+    }
+
+    if (raw >= STEP_DOWN_COUNT) {
+        if (range->step < LADDER_STEPS - 1) {
+            range->step++;
+            return raw == FULL_SCALE_COUNT;
+        }
+        return false;
+    }
+
+    if (range->step > 0) {
+        float predicted = (float)raw * lux_per_count(s_ladder[range->step]) /
+                          lux_per_count(s_ladder[range->step - 1]);
+        if (predicted < STEP_UP_COUNT) {
+            range->step--;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+/**
+* @file lux_stats.c
+ *
+ * Running statistics over the light sub-samples behind one reported reading.
+ *
+ * Several sub-samples spread over each reporting interval stop a passing
+ * cloud from deciding the whole reading. They are reduced on the fly with
+ * Welford's algorithm, which is numerically stable and needs no buffer.
+ *
+ * This module has no ESP-IDF dependencies.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "lux_stats.h"
+#include <math.h>
+#include <string.h>
+
+void lux_stats_reset(lux_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+void lux_stats_add(lux_stats_t *stats, float lux, float duration_s) {
+    if (stats->count == 0 || lux < stats->min) {
+        stats->min = lux;
+    }
+    if (stats->count == 0 || lux > stats->max) {
+        stats->max = lux;
+    }
+
+    stats->count++;
+    float delta = lux - stats->mean;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * (lux - stats->mean);
+    stats->integral += lux * duration_s;
+}
+
+float lux_stats_stddev(const lux_stats_t *stats) {
+    if (stats->count < 2) {
+        return 0.0f;
+    }
+    return sqrtf(stats->m2 / (stats->count - 1));
+}
+
+void lux_stats_to_reading(const lux_stats_t *stats, sensor_reading_t *reading) {
+    reading->lux = stats->mean;
+    reading->lux_min = stats->min;
+    reading->lux_max = stats->max;
+    reading->lux_stddev = lux_stats_stddev(stats);
+    reading->lux_integral = stats->integral;
+    reading->sample_count = stats->count;
+}
@@ -34,13 +34,14 @@
 #include "time_utils.h"
 #include "power_management.h"
 #include "status_reporter.h"
+#include "duty_cycle.h"
+#include "pm_control.h"
+#include "reading_buffer.h"
 
 #define TAG "MAIN"
 
 #define BATCH_POST_INTERVAL_S (5 * 60) // 5 minutes
-// We read every 15 seconds
-#define READING_INTERVAL_S 15
-#define READING_BUFFER_SIZE (BATCH_POST_INTERVAL_S / READING_INTERVAL_S)
+#define READING_BUFFER_SIZE READING_BUFFER_SIZE_FOR(BATCH_POST_INTERVAL_S, CONFIG_SAMPLE_INTERVAL_MIN_S)
 
 // Shared data buffer and its current index
 static sensor_reading_t g_reading_buffer[READING_BUFFER_SIZE];
@@ -48,6 +49,14 @@ static int g_reading_idx = 0;
 
 void app_main(void)
 {
+    // A night wake that landed early goes back to sleep before anything is initialized
+    handle_early_night_wake();
+
+    // Between daytime samples: take one reading and sleep again unless an upload is due.
+    // Needs only the timezone table, so it runs before everything else.
+    time_utils_init();
+    duty_cycle_handle_wake();
+
     // Initialize NVS first
     esp_err_t err = nvs_flash_init();
     if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -59,6 +68,9 @@ void app_main(void)
     // Initialize log capture EARLY - before other logging happens
     log_capture_init();
 
+    // Scale the clock and light sleep between samples; the PM locks are used from here on
+    pm_control_init();
+
     // Filter out noisy WiFi system logs - ADD THESE LINES
     esp_log_level_set("wifi", ESP_LOG_WARN);
     esp_log_level_set("wifi_init", ESP_LOG_WARN);
@@ -122,6 +134,7 @@ void app_main(void)
     app_context->buffer_size = READING_BUFFER_SIZE;
     app_context->buffer_mutex = xSemaphoreCreateMutex();
     app_context->wifi_send_failed = false;  // Initialize failure flag
+    app_context->send_task_handle = NULL;
 
     if (app_context->buffer_mutex == NULL) {
         ESP_LOGE(TAG, "Failed to create mutex!");
@@ -131,7 +144,7 @@ void app_main(void)
 
     // Create and launch the tasks with increased stack sizes to prevent stack overflow
     // Run send data task first to set the local clock correctly
-    xTaskCreate(task_send_data, "send_data_task", 8192, app_context, 5, NULL);  // Increased from 4096
+    xTaskCreate(task_send_data, "send_data_task", 8192, app_context, 5, &app_context->send_task_handle);  // Increased from 4096
     // Give the send_data_task time to connect and perform the initial NTP sync
     vTaskDelay(pdMS_TO_TICKS(10000));
     xTaskCreate(task_get_sensor_data, "sensor_task", 6144, app_context, 5, NULL);  // Increased from 4096
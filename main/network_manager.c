@@ -13,18 +13,51 @@
 #include "network_manager.h"
 #include "app_config.h"
 #include "wifi_manager.h"
+#include "wifi_tx_power.h"
 #include "esp_wifi.h"
 #include "ntp.h"
+#include "http_time.h"
 #include "time_utils.h"
 #include "status_reporter.h"
+#include "adc_battery.h"
+#include "esp_attr.h"
 #include "esp_sleep.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include <string.h>
 
 #define TAG "NETWORK_MANAGER"
 
-// Global time tracking variables
-static bool g_time_is_valid = false;
+#define CONNECT_POLL_INTERVAL_MS 100
+#define CONNECT_POLLS_PER_ATTEMPT (2000 / CONNECT_POLL_INTERVAL_MS)
+
+// Rough current figures for the energy estimate. These are ESP32-C3 datasheet
+// ballparks, not measurements - compare modes on the same board, not absolutely.
+#define RADIO_ACTIVE_MA 85.0f             // RX/TX with power save off
+#define RADIO_ASSOC_IDLE_MA_PER_BEACON 8.0f   // Modem sleep waking every beacon
+#define HTTP_TIME_MAX_SAMPLE_AGE_S (15 * 60)  // Covers the previous send cycle's responses
+
+// Global time tracking variables. Kept across deep sleep, which leaves the RTC clock running.
+static RTC_DATA_ATTR bool g_time_is_valid = false;
+
+/**
+ * @brief Connect latency and radio-on time, accumulated since boot
+ */
+typedef struct {
+    uint32_t cycles;           // initialize_network_connection calls
+    uint32_t reused;           // Cycles that found the association still up
+    uint32_t failures;         // Cycles that ended without a connection
+    int64_t connect_us_total;  // Sum of latency over cycles that had to connect
+    int64_t connect_us_max;
+    int64_t active_us;         // Radio up at full power (connect + transfer)
+    int64_t idle_assoc_us;     // Associated in modem sleep between cycles
+} connectivity_metrics_t;
+
+static connectivity_mode_t s_mode;
+static bool s_mode_resolved = false;
+static connectivity_metrics_t s_metrics;
+static int64_t s_active_since_us = 0;     // Start of the current active window, 0 if none
+static int64_t s_idle_since_us = 0;       // Start of the current associated-idle window, 0 if none
 
 /**
  * @brief Helper structure for timezone callback functions
@@ -68,13 +101,70 @@ static void format_time_status_callback(const struct tm* local_time, time_t now,
              is_system_time_valid() ? "yes" : "no");
 }
 
+connectivity_mode_t network_get_connectivity_mode(void) {
+    if (!s_mode_resolved) {
+#if CONFIG_WIFI_POWER_MODE == WIFI_POWER_MODE_STAY
+        s_mode = CONNECTIVITY_MODE_STAY;
+#elif CONFIG_WIFI_POWER_MODE == WIFI_POWER_MODE_AUTO
+        // Mains/USB power can afford the idle association; a battery usually can't
+        s_mode = adc_battery_is_present() ? CONNECTIVITY_MODE_CYCLE : CONNECTIVITY_MODE_STAY;
+#else
+        s_mode = CONNECTIVITY_MODE_CYCLE;
+#endif
+        s_mode_resolved = true;
+        ESP_LOGI(TAG, "Connectivity mode: %s (listen interval %d)",
+                 s_mode == CONNECTIVITY_MODE_STAY ? "stay associated" : "cycle radio",
+                 CONFIG_WIFI_LISTEN_INTERVAL);
+    }
+    return s_mode;
+}
+
 bool initialize_network_connection(int max_retries) {
+    bool stay = network_get_connectivity_mode() == CONNECTIVITY_MODE_STAY;
+    int64_t start_us = esp_timer_get_time();
+
+    if (s_idle_since_us > 0) {
+        s_metrics.idle_assoc_us += start_us - s_idle_since_us;
+        s_idle_since_us = 0;
+    }
+    s_active_since_us = start_us;
+    s_metrics.cycles++;
+
+    if (stay && wifi_is_connected()) {
+        s_metrics.reused++;
+        wifi_manager_set_idle(false);
+        ESP_LOGI(TAG, "Reusing existing WiFi association");
+        wifi_tx_power_update(true);
+        return true;
+    }
+    if (stay) {
+        // Association was lost while idle; restart the stack so the scan and failover run again
+        wifi_manager_stop();
+    }
+
+    wifi_manager_set_power_save(stay, CONFIG_WIFI_LISTEN_INTERVAL);
     wifi_manager_init();
-    int wifi_retries = max_retries;
-    while (!wifi_is_connected() && wifi_retries-- > 0) {
-        vTaskDelay(pdMS_TO_TICKS(2000));
+
+    // Poll finely so connect latency isn't rounded up to the old 2 s step;
+    // max_retries keeps its meaning of 2 s slots.
+    int polls = max_retries * CONNECT_POLLS_PER_ATTEMPT;
+    while (!wifi_is_connected() && polls-- > 0) {
+        vTaskDelay(pdMS_TO_TICKS(CONNECT_POLL_INTERVAL_MS));
     }
-    return wifi_is_connected();
+
+    if (wifi_is_connected()) {
+        int64_t latency_us = esp_timer_get_time() - start_us;
+        s_metrics.connect_us_total += latency_us;
+        if (latency_us > s_metrics.connect_us_max) {
+            s_metrics.connect_us_max = latency_us;
+        }
+        ESP_LOGI(TAG, "WiFi connected in %lld ms", latency_us / 1000);
+        wifi_tx_power_update(true);
+        return true;
+    }
+    s_metrics.failures++;
+    wifi_tx_power_update(false);
+    return false;
 }
 
 void send_wifi_connection_status(bool is_initial_connection) {
@@ -114,26 +204,63 @@ void send_wifi_connection_status(bool is_initial_connection) {
     }
 }
 
+/**
+ * @brief Take the time from a recent API response instead of SNTP, if enabled
+ *
+ * @return true if the clock was set or confirmed, false if SNTP is needed
+ */
+static bool sync_from_http_time(time_t *last_ntp_sync_time, bool is_initial_boot) {
+#if CONFIG_HTTP_TIME_SOURCE
+    if (!http_time_apply(HTTP_TIME_MAX_SAMPLE_AGE_S, NULL) || !is_system_time_valid()) {
+        ESP_LOGI(TAG, "No usable server time - falling back to SNTP");
+        return false;
+    }
+
+    bool was_valid = g_time_is_valid;
+    g_time_is_valid = true;
+    *last_ntp_sync_time = time(NULL);
+    with_local_timezone(log_system_time_callback, NULL);
+
+    if (!was_valid && is_initial_boot) {
+        char status_msg[128];
+        time_format_data_t data = {
+            .buffer = status_msg,
+            .buffer_size = sizeof(status_msg),
+            .prefix = "http time set"
+        };
+        with_local_timezone(format_time_status_callback, &data);
+        send_status_update_with_retry(status_msg);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 void handle_ntp_sync(time_t *last_ntp_sync_time, bool is_initial_boot) {
     time_t now = time(NULL);
     bool need_sync = false;
     const char* sync_reason = "";
-    const int NTP_SYNC_INTERVAL_S = 60 * 60; // 1 hour
+    uint32_t sync_interval_s = ntp_get_next_sync_interval_s();
 
     // Always sync if time is invalid
     if (!is_system_time_valid() || !g_time_is_valid) {
         need_sync = true;
         sync_reason = "Time invalid, performing NTP sync";
     }
-    // Regular interval sync for valid time
-    else if ((now - *last_ntp_sync_time) >= NTP_SYNC_INTERVAL_S) {
+    // Drift-based interval sync for valid time
+    else if ((now - *last_ntp_sync_time) >= (time_t)sync_interval_s) {
         need_sync = true;
-        sync_reason = "Regular NTP sync interval reached";
+        sync_reason = "NTP sync interval reached";
     }
 
     if (need_sync) {
         ESP_LOGI(TAG, "%s", sync_reason);
 
+        if (sync_from_http_time(last_ntp_sync_time, is_initial_boot)) {
+            return;
+        }
+
         if (!is_system_time_valid() || !g_time_is_valid) {
             // Critical sync needed
             bool ntp_success = initialize_sntp();
@@ -175,7 +302,49 @@ void handle_ntp_sync(time_t *last_ntp_sync_time, bool is_initial_boot) {
 }
 
 void disconnect_wifi_for_power_saving(void) {
-    esp_wifi_disconnect();
-    esp_wifi_stop();
+    int64_t now_us = esp_timer_get_time();
+    if (s_active_since_us > 0) {
+        s_metrics.active_us += now_us - s_active_since_us;
+        s_active_since_us = 0;
+    }
+
+    if (network_get_connectivity_mode() == CONNECTIVITY_MODE_STAY && wifi_is_connected()) {
+        // Keep the association; modem sleep wakes only every listen interval
+        s_idle_since_us = now_us;
+        wifi_manager_set_idle(true);
+        ESP_LOGI(TAG, "WiFi left associated in modem sleep.");
+        return;
+    }
+
+    wifi_manager_stop();
     ESP_LOGI(TAG, "WiFi disconnected to save power.");
-}
\ No newline at end of file
+}
+
+void format_connectivity_report(char *buffer, size_t buffer_size) {
+    int64_t now_us = esp_timer_get_time();
+    int64_t active_us = s_metrics.active_us;
+    int64_t idle_us = s_metrics.idle_assoc_us;
+    if (s_active_since_us > 0) {
+        active_us += now_us - s_active_since_us;
+    }
+    if (s_idle_since_us > 0) {
+        idle_us += now_us - s_idle_since_us;
+    }
+
+    uint32_t connects = s_metrics.cycles - s_metrics.reused - s_metrics.failures;
+    int64_t avg_ms = connects > 0 ? (s_metrics.connect_us_total / connects) / 1000 : 0;
+
+    int listen_interval = CONFIG_WIFI_LISTEN_INTERVAL > 0 ? CONFIG_WIFI_LISTEN_INTERVAL : 1;
+    float idle_ma = RADIO_ASSOC_IDLE_MA_PER_BEACON / listen_interval;
+    float charge_mas = RADIO_ACTIVE_MA * (active_us / 1e6f) + idle_ma * (idle_us / 1e6f);
+    float uptime_h = now_us / 3.6e9f;
+
+    snprintf(buffer, buffer_size,
+             "wifi %s li=%d cycles=%lu reused=%lu fail=%lu connect avg=%lldms max=%lldms "
+             "active=%llds idle=%llds est=%.0fmAh/day",
+             network_get_connectivity_mode() == CONNECTIVITY_MODE_STAY ? "stay" : "cycle", CONFIG_WIFI_LISTEN_INTERVAL,
+             (unsigned long)s_metrics.cycles, (unsigned long)s_metrics.reused,
+             (unsigned long)s_metrics.failures, avg_ms, s_metrics.connect_us_max / 1000,
+             active_us / 1000000, idle_us / 1000000,
+             uptime_h > 0 ? (charge_mas / 3600.0f) * (24.0f / uptime_h) : 0.0f);
+}
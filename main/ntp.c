@@ -1,7 +1,10 @@
 /**
 * @file ntp.c
  *
- * Client for time synchronization with improved reliability
+ * Client for time synchronization with improved reliability.
+ *
+ * Syncs are notification driven and the offset each one corrects is used to
+ * estimate crystal drift, which sets how long we can wait before the next sync.
  *
  * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
  *
@@ -12,7 +15,12 @@
 #include <esp_log.h>
 #include "app_config.h"
 #include "esp_sntp.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "freertos/semphr.h"
 #include "ntp.h"
+#include <math.h>
+#include <sys/time.h>
 #include <time.h>
 
 #define TAG "NTP"
@@ -20,56 +28,217 @@
 // Minimum reasonable timestamp (January 1, 2024)
 #define MIN_REASONABLE_TIMESTAMP 1704067200
 
+#define SNTP_SYNC_TIMEOUT_MS 60000            // Same overall wait as the old 30 x 2 s poll
+#define SYNC_TARGET_ERROR_MS 500              // Clock error we are willing to accumulate between syncs
+#define SYNC_INTERVAL_DEFAULT_S (60 * 60)     // Until drift has been measured
+#define SYNC_INTERVAL_MIN_S (30 * 60)
+#define SYNC_INTERVAL_MAX_S (24 * 60 * 60)
+#define DRIFT_MIN_BASELINE_S (10 * 60)        // Shorter baselines are dominated by network jitter
+#define DRIFT_EWMA_WEIGHT 0.25f
+#define CORRECTION_MIN_OFFSET_US 500000       // Below this no stored timestamp would move
+#define DRIFT_MAX_UNCERTAINTY_PPM 20.0f       // Coarser offsets restart the baseline without moving the estimate
+
+/**
+ * @brief Sync history, kept in RTC memory so the drift estimate survives night deep sleep
+ */
+typedef struct {
+    time_t last_sync_time;      // Wall time of the last successful sync, 0 if none
+    int64_t last_offset_us;     // Correction applied by the last sync
+    float drift_ppm;            // Smoothed clock drift, positive when the local clock runs slow
+    bool drift_valid;
+} ntp_sync_state_t;
+
+static RTC_DATA_ATTR ntp_sync_state_t s_sync_state;
+
+static SemaphoreHandle_t s_sync_semaphore = NULL;
+static int64_t s_wall_at_start_us = 0;      // Local wall clock when SNTP was started
+static int64_t s_timer_at_start_us = 0;     // Monotonic timer at the same instant
+static volatile int64_t s_sync_offset_us = 0;
+static time_correction_t s_pending_correction;
+static bool s_correction_pending = false;
+
 static bool is_time_reasonable(time_t timestamp) {
     return timestamp >= MIN_REASONABLE_TIMESTAMP;
 }
 
-// SNTP initialization with improved reliability
+/**
+ * @brief SNTP notification callback, runs in the lwIP task once the new time is set
+ *
+ * The old clock reading is reconstructed from the monotonic timer, which
+ * settimeofday() does not touch.
+ */
+static void time_sync_notification_cb(struct timeval *tv) {
+    int64_t predicted_us = s_wall_at_start_us + (esp_timer_get_time() - s_timer_at_start_us);
+    int64_t server_us = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+    s_sync_offset_us = server_us - predicted_us;
+    if (s_sync_semaphore != NULL) {
+        xSemaphoreGive(s_sync_semaphore);
+    }
+}
+
+/**
+ * @brief Fold a new offset into the drift estimate
+ *
+ * @param uncertainty_us How far the measured offset may be off, 0 if negligible
+ * @param stepped Whether the clock was moved by the offset; stored readings are only corrected if so
+ */
+static void update_drift_model(time_t synced_at, int64_t offset_us, int64_t uncertainty_us, bool clock_was_valid,
+                               bool stepped) {
+    if (clock_was_valid && s_sync_state.last_sync_time > 0) {
+        time_t baseline_s = synced_at - s_sync_state.last_sync_time;
+
+        // Readings stamped since the previous sync carry part of this error
+        if (stepped && (offset_us >= CORRECTION_MIN_OFFSET_US || offset_us <= -CORRECTION_MIN_OFFSET_US)) {
+            // The window ends at the old clock's reading, except when the clock ran fast:
+            // then readings taken after the step can carry the same timestamps, so stop
+            // at the corrected sync time rather than shift those.
+            time_t pre_step = synced_at - (time_t)(offset_us / 1000000);
+            s_pending_correction.window_start = s_sync_state.last_sync_time;
+            s_pending_correction.window_end = pre_step < synced_at ? pre_step : synced_at;
+            s_pending_correction.offset_us = offset_us;
+            s_correction_pending = true;
+        }
+
+        if (baseline_s >= DRIFT_MIN_BASELINE_S &&
+            (float)uncertainty_us > DRIFT_MAX_UNCERTAINTY_PPM * (float)baseline_s) {
+            ESP_LOGI(TAG, "Clock offset %lld ms (+/- %lld ms) too coarse for drift over %lld s",
+                     offset_us / 1000, uncertainty_us / 1000, (long long)baseline_s);
+        } else if (baseline_s >= DRIFT_MIN_BASELINE_S) {
+            float ppm = (float)offset_us / (float)baseline_s;   // us per s == ppm
+            if (s_sync_state.drift_valid) {
+                s_sync_state.drift_ppm += DRIFT_EWMA_WEIGHT * (ppm - s_sync_state.drift_ppm);
+            } else {
+                s_sync_state.drift_ppm = ppm;
+                s_sync_state.drift_valid = true;
+            }
+            ESP_LOGI(TAG, "Clock offset %lld ms over %lld s (%.1f ppm, smoothed %.1f ppm)",
+                     offset_us / 1000, (long long)baseline_s, ppm, s_sync_state.drift_ppm);
+        }
+    }
+    s_sync_state.last_sync_time = synced_at;
+    s_sync_state.last_offset_us = stepped ? offset_us : 0;
+}
+
 bool initialize_sntp(void)
 {
     ESP_LOGI(TAG, "Initializing SNTP");
 
+    if (s_sync_semaphore == NULL) {
+        s_sync_semaphore = xSemaphoreCreateBinary();
+        if (s_sync_semaphore == NULL) {
+            ESP_LOGE(TAG, "Failed to create SNTP sync semaphore");
+            return false;
+        }
+    }
+
     // Stop any existing SNTP service
     if (esp_sntp_enabled()) {
         esp_sntp_stop();
     }
+    xSemaphoreTake(s_sync_semaphore, 0);    // Drop a stale notification
+
+    bool clock_was_valid = is_system_time_valid();
+    struct timeval tv_start;
+    gettimeofday(&tv_start, NULL);
+    s_timer_at_start_us = esp_timer_get_time();
+    s_wall_at_start_us = (int64_t)tv_start.tv_sec * 1000000LL + tv_start.tv_usec;
 
     esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
     esp_sntp_setservername(0, "pool.ntp.org");
     esp_sntp_setservername(1, "time.google.com");
     esp_sntp_setservername(2, "time.cloudflare.com");
+    sntp_set_time_sync_notification_cb(time_sync_notification_cb);
     esp_sntp_init();
 
-    // Wait for time to be set with better validation
-    time_t now = 0;
-    struct tm timeinfo = { 0 };
-    int retry = 0;
-    const int retry_count = 30; // Increased retry count
-
-    while (retry < retry_count) {
-        time(&now);
-
-        // Check if SNTP sync is complete AND time is reasonable
-        if (esp_sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED && is_time_reasonable(now)) {
-            localtime_r(&now, &timeinfo);
-            ESP_LOGI(TAG, "Time synchronized successfully: %04d-%02d-%02d %02d:%02d:%02d UTC",
-                     timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
-                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-            return true;
-        }
+    // Returns as soon as the first server response has set the clock
+    bool notified = xSemaphoreTake(s_sync_semaphore, pdMS_TO_TICKS(SNTP_SYNC_TIMEOUT_MS)) == pdTRUE;
+    int64_t waited_ms = (esp_timer_get_time() - s_timer_at_start_us) / 1000;
+
+    // Scheduling is ours now; don't let SNTP's own poll timer wake the radio
+    esp_sntp_stop();
 
-        retry++;
-        ESP_LOGI(TAG, "Waiting for system time to be set... (%d/%d) [sync_status=%d, timestamp=%lld]",
-                 retry, retry_count, esp_sntp_get_sync_status(), (long long)now);
-        vTaskDelay(2000 / portTICK_PERIOD_MS);
+    time_t now = time(NULL);
+    if (notified && is_time_reasonable(now)) {
+        update_drift_model(now, s_sync_offset_us, 0, clock_was_valid, true);
+
+        struct tm timeinfo = { 0 };
+        gmtime_r(&now, &timeinfo);
+        ESP_LOGI(TAG, "Time synchronized in %lld ms: %04d-%02d-%02d %02d:%02d:%02d UTC (offset %lld ms, next sync in %lu s)",
+                 waited_ms, timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+                 timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec,
+                 s_sync_offset_us / 1000, (unsigned long)ntp_get_next_sync_interval_s());
+        return true;
     }
 
-    time(&now);
-    ESP_LOGE(TAG, "SNTP synchronization failed after %d attempts. Current timestamp: %lld (reasonable: %s)",
-             retry_count, (long long)now, is_time_reasonable(now) ? "yes" : "no");
+    ESP_LOGE(TAG, "SNTP synchronization failed after %lld ms. Current timestamp: %lld (reasonable: %s)",
+             waited_ms, (long long)now, is_time_reasonable(now) ? "yes" : "no");
     return false;
 }
 
+bool ntp_apply_offset(int64_t offset_us, int64_t uncertainty_us) {
+    bool clock_was_valid = is_system_time_valid();
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    int64_t corrected_us = (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec + offset_us;
+    tv.tv_sec = corrected_us / 1000000LL;
+    tv.tv_usec = corrected_us % 1000000LL;
+    if (settimeofday(&tv, NULL) != 0) {
+        ESP_LOGE(TAG, "Failed to step the clock by %lld ms", offset_us / 1000);
+        return false;
+    }
+
+    time_t now = time(NULL);
+    if (is_time_reasonable(now)) {
+        update_drift_model(now, offset_us, uncertainty_us, clock_was_valid, true);
+    }
+    return true;
+}
+
+void ntp_confirm_offset(int64_t offset_us, int64_t uncertainty_us) {
+    time_t now = time(NULL);
+    if (is_system_time_valid() && is_time_reasonable(now)) {
+        update_drift_model(now, offset_us, uncertainty_us, true, false);
+    }
+}
+
+bool ntp_take_time_correction(time_correction_t *correction) {
+    if (!s_correction_pending || correction == NULL) {
+        return false;
+    }
+    *correction = s_pending_correction;
+    s_correction_pending = false;
+    return true;
+}
+
+int64_t ntp_get_last_offset_us(void) {
+    return s_sync_state.last_offset_us;
+}
+
+bool ntp_get_drift_ppm(float *drift_ppm) {
+    if (!s_sync_state.drift_valid) {
+        return false;
+    }
+    *drift_ppm = s_sync_state.drift_ppm;
+    return true;
+}
+
+uint32_t ntp_get_next_sync_interval_s(void) {
+    if (!s_sync_state.drift_valid) {
+        return SYNC_INTERVAL_DEFAULT_S;
+    }
+
+    // Time for the clock to wander SYNC_TARGET_ERROR_MS at the measured rate
+    float ppm = fabsf(s_sync_state.drift_ppm);
+    float interval_s = ppm > 0.0f ? (SYNC_TARGET_ERROR_MS * 1000.0f) / ppm : SYNC_INTERVAL_MAX_S;
+    if (interval_s < SYNC_INTERVAL_MIN_S) {
+        return SYNC_INTERVAL_MIN_S;
+    }
+    if (interval_s > SYNC_INTERVAL_MAX_S) {
+        return SYNC_INTERVAL_MAX_S;
+    }
+    return (uint32_t)interval_s;
+}
+
 bool is_system_time_valid(void) {
     time_t now;
     time(&now);
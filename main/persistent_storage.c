@@ -17,6 +17,7 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -24,11 +25,138 @@
 #define NVS_NAMESPACE "sensor_data"
 #define KEY_BATCH_COUNT "batch_count"
 #define KEY_BATCH_PREFIX "batch_"
+#define KEY_LAYOUT_VERSION "layout_ver"
+
+// Bump when sensor_reading_t changes; batches in an unknown layout are discarded
+#define STORAGE_LAYOUT_VERSION 3
+
+/**
+ * @brief Reading layout written before the layout version key existed
+ */
+typedef struct {
+    time_t timestamp;
+    float lux;
+    float chip_temp_c;
+    float chip_temp_f;
+} sensor_reading_v1_t;
+
+/**
+ * @brief Reading layout version 2, before the light statistics
+ */
+typedef struct {
+    time_t timestamp;
+    float lux;
+    float chip_temp_c;
+    float chip_temp_f;
+    int64_t mono_us;
+    uint32_t boot_id;
+    bool provisional;
+} sensor_reading_v2_t;
 
 static nvs_handle_t s_nvs_handle = 0;
 static bool s_initialized = false;
 static SemaphoreHandle_t s_nvs_mutex = NULL;
 
+/**
+ * @brief Convert one stored batch from an older layout in place
+ *
+ * Readings from before the light statistics count as a single sample.
+ */
+static esp_err_t migrate_batch(const char *batch_key, uint8_t from_version) {
+    size_t required_size = 0;
+    esp_err_t err = nvs_get_blob(s_nvs_handle, batch_key, NULL, &required_size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    size_t old_size = (from_version == 1) ? sizeof(sensor_reading_v1_t) : sizeof(sensor_reading_v2_t);
+    int count = required_size / old_size;
+    uint8_t *old_batch = malloc(required_size);
+    sensor_reading_t *new_batch = calloc(count > 0 ? count : 1, sizeof(sensor_reading_t));
+    if (old_batch == NULL || new_batch == NULL) {
+        free(old_batch);
+        free(new_batch);
+        return ESP_ERR_NO_MEM;
+    }
+
+    err = nvs_get_blob(s_nvs_handle, batch_key, old_batch, &required_size);
+    if (err == ESP_OK) {
+        for (int i = 0; i < count; i++) {
+            sensor_reading_t *reading = &new_batch[i];
+            if (from_version == 1) {
+                const sensor_reading_v1_t *old = (const sensor_reading_v1_t *)old_batch + i;
+                reading->timestamp = old->timestamp;
+                reading->lux = old->lux;
+                reading->chip_temp_c = old->chip_temp_c;
+                reading->chip_temp_f = old->chip_temp_f;
+            } else {
+                const sensor_reading_v2_t *old = (const sensor_reading_v2_t *)old_batch + i;
+                reading->timestamp = old->timestamp;
+                reading->lux = old->lux;
+                reading->chip_temp_c = old->chip_temp_c;
+                reading->chip_temp_f = old->chip_temp_f;
+                reading->mono_us = old->mono_us;
+                reading->boot_id = old->boot_id;
+                reading->provisional = old->provisional;
+            }
+            reading->lux_min = reading->lux;
+            reading->lux_max = reading->lux;
+            reading->sample_count = 1;
+        }
+        err = nvs_set_blob(s_nvs_handle, batch_key, new_batch, count * sizeof(sensor_reading_t));
+    }
+
+    free(old_batch);
+    free(new_batch);
+    return err;
+}
+
+/**
+ * @brief Bring stored batches up to the current reading layout
+ */
+static void check_storage_layout(void) {
+    uint8_t layout_version = 0;
+    esp_err_t err = nvs_get_u8(s_nvs_handle, KEY_LAYOUT_VERSION, &layout_version);
+    if (err == ESP_OK && layout_version == STORAGE_LAYOUT_VERSION) {
+        return;
+    }
+
+    // No version key: written by firmware that used the version 1 layout
+    uint8_t from_version = (err == ESP_ERR_NVS_NOT_FOUND) ? 1 : layout_version;
+    bool can_migrate = (err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND) &&
+                       from_version >= 1 && from_version < STORAGE_LAYOUT_VERSION;
+
+    int32_t batch_count = 0;
+    nvs_get_i32(s_nvs_handle, KEY_BATCH_COUNT, &batch_count);
+
+    for (int i = 0; i < batch_count; i++) {
+        char batch_key[32];
+        snprintf(batch_key, sizeof(batch_key), "%s%d", KEY_BATCH_PREFIX, i);
+
+        if (can_migrate) {
+            esp_err_t migrate_err = migrate_batch(batch_key, from_version);
+            if (migrate_err != ESP_OK) {
+                ESP_LOGW(TAG, "Dropping batch '%s' that could not be migrated: %s",
+                         batch_key, esp_err_to_name(migrate_err));
+                nvs_erase_key(s_nvs_handle, batch_key);
+            }
+        } else {
+            nvs_erase_key(s_nvs_handle, batch_key);
+        }
+    }
+
+    if (can_migrate) {
+        ESP_LOGI(TAG, "Migrated %d stored batches from layout version %d to %d",
+                 (int)batch_count, from_version, STORAGE_LAYOUT_VERSION);
+    } else {
+        ESP_LOGW(TAG, "Discarded %d stored batches in unknown layout version %d", (int)batch_count, layout_version);
+        nvs_erase_key(s_nvs_handle, KEY_BATCH_COUNT);
+    }
+
+    nvs_set_u8(s_nvs_handle, KEY_LAYOUT_VERSION, STORAGE_LAYOUT_VERSION);
+    nvs_commit(s_nvs_handle);
+}
+
 esp_err_t persistent_storage_init(void) {
     if (s_initialized) {
         return ESP_OK;
@@ -48,6 +176,8 @@ esp_err_t persistent_storage_init(void) {
         return err;
     }
 
+    check_storage_layout();
+
     s_initialized = true;
     ESP_LOGI(TAG, "Persistent storage initialized");
     return ESP_OK;
@@ -182,6 +312,118 @@ esp_err_t persistent_storage_load_readings(sensor_reading_t* readings, int max_c
     return ESP_OK;
 }
 
+esp_err_t persistent_storage_load_newest_batch(sensor_reading_t* readings, int max_count,
+                                               int* loaded_count, int* batch_index) {
+    if (!s_initialized || s_nvs_mutex == NULL) {
+        ESP_LOGE(TAG, "Storage not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (loaded_count == NULL || batch_index == NULL || (readings != NULL && max_count <= 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *loaded_count = 0;
+    *batch_index = -1;
+
+    if (xSemaphoreTake(s_nvs_mutex, portMAX_DELAY) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to take NVS mutex");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int32_t batch_count = 0;
+    esp_err_t err = nvs_get_i32(s_nvs_handle, KEY_BATCH_COUNT, &batch_count);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        xSemaphoreGive(s_nvs_mutex);
+        return ESP_OK;
+    } else if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to get batch count: %s", esp_err_to_name(err));
+        xSemaphoreGive(s_nvs_mutex);
+        return err;
+    }
+
+    // Removed batches can leave gaps below the count, so take the highest one present
+    err = ESP_OK;
+    for (int i = batch_count - 1; i >= 0; i--) {
+        char batch_key[32];
+        snprintf(batch_key, sizeof(batch_key), "%s%d", KEY_BATCH_PREFIX, i);
+
+        size_t required_size = 0;
+        if (nvs_get_blob(s_nvs_handle, batch_key, NULL, &required_size) != ESP_OK) {
+            continue;
+        }
+
+        int readings_in_batch = required_size / sizeof(sensor_reading_t);
+        if (readings == NULL) {
+            *loaded_count = readings_in_batch;
+        } else if (readings_in_batch > max_count) {
+            ESP_LOGE(TAG, "Batch '%s' has %d readings, buffer holds %d", batch_key, readings_in_batch, max_count);
+            err = ESP_ERR_INVALID_SIZE;
+        } else {
+            err = nvs_get_blob(s_nvs_handle, batch_key, readings, &required_size);
+            if (err == ESP_OK) {
+                *loaded_count = readings_in_batch;
+            } else {
+                ESP_LOGE(TAG, "Failed to load batch '%s': %s", batch_key, esp_err_to_name(err));
+            }
+        }
+        *batch_index = i;
+        break;
+    }
+
+    xSemaphoreGive(s_nvs_mutex);
+    return err;
+}
+
+esp_err_t persistent_storage_remove_batch(int batch_index) {
+    if (!s_initialized || s_nvs_mutex == NULL) {
+        ESP_LOGE(TAG, "Storage not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (batch_index < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (xSemaphoreTake(s_nvs_mutex, portMAX_DELAY) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to take NVS mutex");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    char batch_key[32];
+    snprintf(batch_key, sizeof(batch_key), "%s%d", KEY_BATCH_PREFIX, batch_index);
+    esp_err_t err = nvs_erase_key(s_nvs_handle, batch_key);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGE(TAG, "Failed to erase batch '%s': %s", batch_key, esp_err_to_name(err));
+        xSemaphoreGive(s_nvs_mutex);
+        return err;
+    }
+
+    // Trim the count past any batches that are gone from the top
+    int32_t batch_count = 0;
+    nvs_get_i32(s_nvs_handle, KEY_BATCH_COUNT, &batch_count);
+    int32_t new_count = batch_count;
+    while (new_count > 0) {
+        size_t required_size = 0;
+        snprintf(batch_key, sizeof(batch_key), "%s%d", KEY_BATCH_PREFIX, (int)(new_count - 1));
+        if (nvs_get_blob(s_nvs_handle, batch_key, NULL, &required_size) == ESP_OK) {
+            break;
+        }
+        new_count--;
+    }
+    if (new_count == 0) {
+        nvs_erase_key(s_nvs_handle, KEY_BATCH_COUNT);
+    } else if (new_count != batch_count) {
+        nvs_set_i32(s_nvs_handle, KEY_BATCH_COUNT, new_count);
+    }
+
+    err = nvs_commit(s_nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to commit batch removal: %s", esp_err_to_name(err));
+    }
+
+    xSemaphoreGive(s_nvs_mutex);
+    return err;
+}
+
 esp_err_t persistent_storage_clear_readings(void) {
     if (!s_initialized || s_nvs_mutex == NULL) {
         ESP_LOGE(TAG, "Storage not initialized");
@@ -257,4 +499,106 @@ esp_err_t persistent_storage_get_count(int* count) {
 
     xSemaphoreGive(s_nvs_mutex);
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+int persistent_storage_correct_timestamps(sensor_reading_t* readings, int count,
+                                          const time_correction_t* correction) {
+    if (readings == NULL || correction == NULL || correction->window_end <= correction->window_start) {
+        return 0;
+    }
+
+    int64_t window_s = correction->window_end - correction->window_start;
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        time_t t = readings[i].timestamp;
+        if (t <= correction->window_start || t > correction->window_end) {
+            continue;
+        }
+        // Share of the final offset accumulated by the time of this reading, rounded to a second
+        int64_t elapsed_s = t - correction->window_start;
+        int64_t delta_us = correction->offset_us * elapsed_s / window_s;
+        int64_t delta_s = (delta_us + (delta_us >= 0 ? 500000 : -500000)) / 1000000;
+        if (delta_s != 0) {
+            readings[i].timestamp = t + (time_t)delta_s;
+            changed++;
+        }
+    }
+    return changed;
+}
+
+esp_err_t persistent_storage_apply_time_correction(const time_correction_t* correction) {
+    if (!s_initialized || s_nvs_mutex == NULL) {
+        ESP_LOGE(TAG, "Storage not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (correction == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (xSemaphoreTake(s_nvs_mutex, portMAX_DELAY) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to take NVS mutex");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int32_t batch_count = 0;
+    esp_err_t err = nvs_get_i32(s_nvs_handle, KEY_BATCH_COUNT, &batch_count);
+    if (err == ESP_ERR_NVS_NOT_FOUND || batch_count == 0) {
+        xSemaphoreGive(s_nvs_mutex);
+        return ESP_OK;
+    } else if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to get batch count: %s", esp_err_to_name(err));
+        xSemaphoreGive(s_nvs_mutex);
+        return err;
+    }
+
+    int total_changed = 0;
+    int batches_rewritten = 0;
+    for (int i = 0; i < batch_count; i++) {
+        char batch_key[32];
+        snprintf(batch_key, sizeof(batch_key), "%s%d", KEY_BATCH_PREFIX, i);
+
+        size_t required_size = 0;
+        if (nvs_get_blob(s_nvs_handle, batch_key, NULL, &required_size) != ESP_OK || required_size == 0) {
+            continue;
+        }
+
+        sensor_reading_t *batch = malloc(required_size);
+        if (batch == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate buffer for batch '%s'", batch_key);
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        if (nvs_get_blob(s_nvs_handle, batch_key, batch, &required_size) == ESP_OK) {
+            int changed = persistent_storage_correct_timestamps(
+                batch, required_size / sizeof(sensor_reading_t), correction);
+            // Only rewrite batches that actually moved, to spare the flash
+            if (changed > 0) {
+                err = nvs_set_blob(s_nvs_handle, batch_key, batch, required_size);
+                if (err != ESP_OK) {
+                    ESP_LOGE(TAG, "Failed to rewrite batch '%s': %s", batch_key, esp_err_to_name(err));
+                    free(batch);
+                    break;
+                }
+                total_changed += changed;
+                batches_rewritten++;
+            }
+        }
+        free(batch);
+    }
+
+    if (batches_rewritten > 0) {
+        esp_err_t commit_err = nvs_commit(s_nvs_handle);
+        if (commit_err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to commit time correction: %s", esp_err_to_name(commit_err));
+            err = commit_err;
+        }
+    }
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Time correction adjusted %d stored readings in %d batches",
+                 total_changed, batches_rewritten);
+    }
+
+    xSemaphoreGive(s_nvs_mutex);
+    return err;
+}
@@ -0,0 +1,116 @@
+/**
+* @file pm_control.c
+ *
+ * Dynamic frequency scaling, automatic light sleep and the PM locks around peripheral work.
+ *
+ * Both tasks spend nearly all their time in vTaskDelay. With power management
+ * on, the tickless idle task drops the CPU to the crystal frequency and puts
+ * the chip into light sleep whenever nothing holds a lock. Locks are only
+ * held around I2C transactions, ADC sampling and HTTP requests. With
+ * CONFIG_PM_PROFILING the time spent in each mode is reported, so the actual
+ * light sleep share can be compared between USB and battery units.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "pm_control.h"
+#include "sdkconfig.h"
+#include "esp_pm.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TAG "PM_CONTROL"
+
+#define PM_MIN_FREQ_MHZ 40                  // Crystal frequency
+#define PM_DUMP_BUFFER_SIZE 768
+
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t s_locks[PM_LOCK_COUNT];
+#endif
+
+esp_err_t pm_control_init(void) {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = PM_MIN_FREQ_MHZ,
+        .light_sleep_enable = true,
+    };
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure power management: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    static const struct {
+        esp_pm_lock_type_t type;
+        const char *name;
+    } lock_defs[PM_LOCK_COUNT] = {
+        [PM_LOCK_I2C] = { ESP_PM_APB_FREQ_MAX, "i2c" },
+        [PM_LOCK_ADC] = { ESP_PM_APB_FREQ_MAX, "adc" },
+        [PM_LOCK_HTTP] = { ESP_PM_CPU_FREQ_MAX, "http" },
+    };
+    for (int i = 0; i < PM_LOCK_COUNT; i++) {
+        err = esp_pm_lock_create(lock_defs[i].type, 0, lock_defs[i].name, &s_locks[i]);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create %s lock: %s", lock_defs[i].name, esp_err_to_name(err));
+            return err;
+        }
+    }
+
+    ESP_LOGI(TAG, "Power management enabled: %d-%d MHz, automatic light sleep",
+             PM_MIN_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+#else
+    ESP_LOGI(TAG, "Power management not enabled in sdkconfig");
+#endif
+    return ESP_OK;
+}
+
+void pm_control_acquire(pm_lock_id_t lock) {
+#if CONFIG_PM_ENABLE
+    if (lock < PM_LOCK_COUNT && s_locks[lock] != NULL) {
+        esp_pm_lock_acquire(s_locks[lock]);
+    }
+#endif
+}
+
+void pm_control_release(pm_lock_id_t lock) {
+#if CONFIG_PM_ENABLE
+    if (lock < PM_LOCK_COUNT && s_locks[lock] != NULL) {
+        esp_pm_lock_release(s_locks[lock]);
+    }
+#endif
+}
+
+int pm_control_log_stats(void) {
+#if CONFIG_PM_ENABLE && CONFIG_PM_PROFILING
+    static char dump[PM_DUMP_BUFFER_SIZE];
+    memset(dump, 0, sizeof(dump));
+
+    FILE *stream = fmemopen(dump, sizeof(dump) - 1, "w");
+    if (stream == NULL) {
+        ESP_LOGW(TAG, "Could not open a buffer for PM statistics");
+        return -1;
+    }
+    esp_pm_dump_locks(stream);
+    fclose(stream);
+
+    // One log line per row, so the table is kept by log capture
+    int sleep_percent = -1;
+    char *save_ptr = NULL;
+    for (char *line = strtok_r(dump, "\n", &save_ptr); line != NULL; line = strtok_r(NULL, "\n", &save_ptr)) {
+        ESP_LOGI(TAG, "%s", line);
+        int percent;
+        if (sscanf(line, " SLEEP %*s %*lld %d%%", &percent) == 1) {
+            sleep_percent = percent;
+        }
+    }
+    return sleep_percent;
+#else
+    return -1;
+#endif
+}
@@ -14,12 +14,73 @@
 #include "time_utils.h"
 #include "app_config.h"
 #include "adc_battery.h"  // Changed from "battery_monitor.h"
+#include "ntp.h"
+#include "esp_attr.h"
 #include "esp_sleep.h"
 #include "esp_log.h"
 #include "driver/rtc_io.h"
+#include <math.h>
+#include <time.h>
 
 #define TAG "POWER_MGMT"
 
+#define EARLY_WAKE_TOLERANCE_S 60           // Closer than this to the night end, sleep out the rest exactly
+#define SLEEP_MIN_MARGIN_S 30               // Always wake at least this much early
+#define SLEEP_DRIFT_DEFAULT_PPM 5000.0f     // RTC slow clock error assumed until drift is measured
+#define SLEEP_DRIFT_MIN_PPM 500.0f
+#define WAKE_SANITY_MIN_S (10 * 60)         // Wakes further than this from plan mean the clock is suspect
+
+/**
+ * @brief Planned night wake, kept in RTC memory for the early-wake fast path
+ */
+typedef struct {
+    time_t night_end;                       // When the night period ends, 0 if not sleeping for the night
+    time_t expected_wake;                   // When the timer should fire
+    uint32_t planned_sleep_s;
+    uint16_t early_wakes;                   // Fast-path re-sleeps this night
+} night_sleep_state_t;
+
+static RTC_DATA_ATTR night_sleep_state_t s_night_sleep;
+
+/**
+ * @brief Shorten a sleep by the expected RTC drift so the wake lands early, not late
+ */
+static uint64_t apply_drift_margin(uint64_t sleep_us) {
+    float ppm = SLEEP_DRIFT_DEFAULT_PPM;
+    float measured_ppm;
+    if (ntp_get_drift_ppm(&measured_ppm)) {
+        ppm = fmaxf(2.0f * fabsf(measured_ppm), SLEEP_DRIFT_MIN_PPM);
+    }
+
+    uint64_t margin_us = (uint64_t)((double)sleep_us * ppm / 1e6);
+    if (margin_us < SLEEP_MIN_MARGIN_S * 1000000ULL) {
+        margin_us = SLEEP_MIN_MARGIN_S * 1000000ULL;
+    }
+    if (margin_us > sleep_us / 2) {
+        margin_us = sleep_us / 2;
+    }
+    return sleep_us - margin_us;
+}
+
+/**
+ * @brief Deep sleep for a set time, recording the plan in RTC memory
+ */
+static void start_night_sleep(time_t now, time_t night_end, uint64_t sleep_us) {
+    s_night_sleep.night_end = night_end;
+    s_night_sleep.planned_sleep_s = (uint32_t)(sleep_us / 1000000ULL);
+    s_night_sleep.expected_wake = now + s_night_sleep.planned_sleep_s;
+
+    esp_sleep_enable_timer_wakeup(sleep_us);
+    esp_deep_sleep_start();
+}
+
+/**
+ * @brief Deep sleep toward the end of the night, waking early by the expected drift
+ */
+static void sleep_until_night_end(time_t now, time_t night_end) {
+    start_night_sleep(now, night_end, apply_drift_margin((uint64_t)(night_end - now) * 1000000ULL));
+}
+
 bool should_enter_deep_sleep(void) {
     // Only ESP32-C3 supports our deep sleep implementation
 #if !CONFIG_IDF_TARGET_ESP32C3
@@ -62,12 +123,63 @@ void enter_night_sleep(void) {
 
     ESP_LOGI(TAG, "Entering deep sleep for %llu minutes", sleep_time / (60 * 1000000ULL));
 
-    // Configure wake up source - timer only for now
-    esp_sleep_enable_timer_wakeup(sleep_time);
+    if (!is_system_time_valid()) {
+        // No clock to plan an exact wake against - periodic check-in
+        s_night_sleep.night_end = 0;
+        esp_sleep_enable_timer_wakeup(sleep_time);
+        esp_deep_sleep_start();
+    }
 
     // Enter deep sleep with automatic power domain configuration
     // ESP32-C3 will automatically configure power domains for optimal deep sleep
-    esp_deep_sleep_start();
+    s_night_sleep.early_wakes = 0;
+    time_t now = time(NULL);
+    sleep_until_night_end(now, now + (time_t)(sleep_time / 1000000ULL));
+}
+
+void handle_early_night_wake(void) {
+    if (s_night_sleep.night_end == 0 || esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) {
+        s_night_sleep.night_end = 0;
+        return;
+    }
+
+    time_t night_end = s_night_sleep.night_end;
+    s_night_sleep.night_end = 0;
+    if (!is_system_time_valid()) {
+        return;
+    }
+
+    // The RTC clock should land near the planned wake; if not, don't trust it
+    time_t now = time(NULL);
+    time_t sanity_s = s_night_sleep.planned_sleep_s / 10;
+    if (sanity_s < WAKE_SANITY_MIN_S) {
+        sanity_s = WAKE_SANITY_MIN_S;
+    }
+    time_t deviation = now - s_night_sleep.expected_wake;
+    if (deviation > sanity_s || deviation < -sanity_s) {
+        ESP_LOGW(TAG, "Woke %lld s from the planned time - clock suspect, doing a full boot",
+                 (long long)deviation);
+        return;
+    }
+
+    if (night_end - now <= EARLY_WAKE_TOLERANCE_S) {
+        if (night_end >= now) {
+            // Drift over the remainder is well under a second, so sleep it out exactly
+            // (plus a second for rounding) rather than boot fully while it's still night
+            s_night_sleep.early_wakes++;
+            ESP_LOGI(TAG, "Woke %lld s before night end - sleeping out the remainder",
+                     (long long)(night_end - now));
+            start_night_sleep(now, night_end, (uint64_t)(night_end - now + 1) * 1000000ULL);
+        }
+        ESP_LOGI(TAG, "Night wake on time (%lld s late, %u fast-path re-sleeps)",
+                 (long long)(now - night_end), s_night_sleep.early_wakes);
+        return;
+    }
+
+    // Still too early: straight back to sleep for the remainder, before any other init
+    s_night_sleep.early_wakes++;
+    ESP_LOGI(TAG, "Woke %lld s before night end - sleeping again", (long long)(night_end - now));
+    sleep_until_night_end(now, night_end);
 }
 
 esp_sleep_wakeup_cause_t check_wakeup_reason(void) {
@@ -0,0 +1,36 @@
+/**
+* @file reading_buffer.c
+ *
+ * Sizing of the shared reading buffer and the mark at which the send task drains it early.
+ *
+ * The sensor task wakes the send task once, when the buffer crosses the
+ * high-water mark. A mark of one reading would wake it for the first reading
+ * of every cycle and double the WiFi connections, so the mark is clamped.
+ *
+ * This module has no ESP-IDF dependencies.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "reading_buffer.h"
+
+#define HIGH_WATER_MIN 2
+
+int reading_buffer_high_water_mark(int buffer_size) {
+    // Too small to have a mark short of full; the full-buffer spill handles it
+    if (buffer_size <= HIGH_WATER_MIN) {
+        return buffer_size;
+    }
+
+    int mark = buffer_size * READING_BUFFER_HIGH_WATER_PERCENT / 100;
+    if (mark < HIGH_WATER_MIN) {
+        mark = HIGH_WATER_MIN;
+    } else if (mark >= buffer_size) {
+        mark = buffer_size - 1;
+    }
+    return mark;
+}
@@ -0,0 +1,111 @@
+/**
+* @file sampling_scheduler.c
+ *
+ * Readings on wall-clock boundaries, with a histogram of how late each one fires.
+ *
+ * Delaying a fixed 15 seconds after each reading lets the period creep by the
+ * processing time, and every device samples at its own offset. Waiting for
+ * the next multiple of the period on the wall clock instead keeps each device
+ * on :00, :15, :30 and :45 and lines readings up across the fleet. The target
+ * is recomputed from the wall clock, so NTP corrections re-anchor the
+ * schedule on the next wait. A step backwards would leave the task asleep for
+ * the size of the step, so a wait gives up once its target is further away
+ * than the caller allows.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "sampling_scheduler.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <sys/time.h>
+
+#define TAG "SAMPLING_SCHEDULER"
+
+#define CLOCK_STEP_MS 1000                  // Later than this, the clock moved during the wait
+
+// Upper bounds of the histogram buckets in milliseconds; the last bucket is open
+static const uint32_t s_bucket_limits_ms[] = { 10, 20, 50, 100, 500 };
+#define JITTER_BUCKETS ((int)(sizeof(s_bucket_limits_ms) / sizeof(s_bucket_limits_ms[0])) + 1)
+
+// Counts since boot, written by the sensor task and only read elsewhere
+static uint32_t s_jitter_counts[JITTER_BUCKETS];
+static uint32_t s_clock_steps = 0;
+
+int64_t sampling_scheduler_now_ms(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+int64_t sampling_scheduler_next_boundary_ms(int64_t now_ms, uint32_t period_ms) {
+    if (period_ms == 0) {
+        return now_ms;
+    }
+    return (now_ms / period_ms + 1) * (int64_t)period_ms;
+}
+
+/**
+ * @brief Add one wake to the jitter histogram
+ *
+ * @param late_ms How long after the target the task woke
+ */
+static void record_jitter(int64_t late_ms) {
+    if (late_ms > CLOCK_STEP_MS) {
+        s_clock_steps++;
+        return;
+    }
+
+    int bucket = 0;
+    while (bucket < JITTER_BUCKETS - 1 && late_ms >= s_bucket_limits_ms[bucket]) {
+        bucket++;
+    }
+    s_jitter_counts[bucket]++;
+}
+
+bool sampling_scheduler_wait_until(int64_t target_ms, uint32_t max_wait_ms) {
+    int64_t now_ms = sampling_scheduler_now_ms();
+    if (now_ms >= target_ms) {
+        return false;
+    }
+
+    // vTaskDelay can return up to a tick early, so keep going until the target has passed
+    while (now_ms < target_ms) {
+        // A target further away than the caller ever asks for means the clock
+        // stepped back; hand control back so the caller can plan from the new time
+        if (target_ms - now_ms > max_wait_ms) {
+            ESP_LOGW(TAG, "Clock stepped back %lld ms - abandoning the wait",
+                     (long long)(target_ms - now_ms - max_wait_ms));
+            s_clock_steps++;
+            return false;
+        }
+        int64_t remaining_ms = target_ms - now_ms;
+        vTaskDelay((TickType_t)((remaining_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS));
+        now_ms = sampling_scheduler_now_ms();
+    }
+
+    record_jitter(now_ms - target_ms);
+    return true;
+}
+
+void sampling_scheduler_format_jitter(char *buffer, size_t buffer_size) {
+    int len = snprintf(buffer, buffer_size, "sample jitter ms");
+    for (int i = 0; i < JITTER_BUCKETS && len < (int)buffer_size; i++) {
+        if (i < JITTER_BUCKETS - 1) {
+            len += snprintf(buffer + len, buffer_size - len, " <%lu:%lu",
+                            (unsigned long)s_bucket_limits_ms[i], (unsigned long)s_jitter_counts[i]);
+        } else {
+            len += snprintf(buffer + len, buffer_size - len, " >=%lu:%lu",
+                            (unsigned long)s_bucket_limits_ms[i - 1], (unsigned long)s_jitter_counts[i]);
+        }
+    }
+    if (len < (int)buffer_size) {
+        snprintf(buffer + len, buffer_size - len, " clock steps:%lu", (unsigned long)s_clock_steps);
+    }
+}
@@ -0,0 +1,70 @@
+/**
+* @file send_schedule.c
+ *
+ * Per-device upload phase and jittered retries, so a fleet that boots together doesn't send together.
+ *
+ * Every sensor sends every 5 minutes. Counting the interval from boot puts a
+ * fleet that lost power together, or an AP restart, into lockstep POSTs.
+ * Instead each device sends at a fixed offset within every 5 minutes of
+ * wall-clock time, taken from an FNV-1a hash of its sensor ID, plus a few
+ * seconds of random jitter. Retries back off exponentially with jitter, and
+ * the first connection after power-on waits a random moment.
+ *
+ * The random source is passed in (esp_random on the device), so this module
+ * has no ESP-IDF dependencies and the fleet's arrival pattern can be
+ * simulated on the host.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "send_schedule.h"
+
+#define SEND_JITTER_MAX_S 10
+#define RETRY_BASE_DELAY_MS 5000
+#define RETRY_MAX_DELAY_MS 60000
+#define BOOT_DELAY_MAX_MS 30000
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+uint32_t send_schedule_phase_s(const char *sensor_id, uint32_t interval_s) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (const char *c = sensor_id; *c != '\0'; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= FNV_PRIME;
+    }
+    return interval_s > 0 ? hash % interval_s : 0;
+}
+
+time_t send_schedule_next_send_time(const char *sensor_id, time_t now, uint32_t interval_s,
+                                    send_schedule_random_t next_random) {
+    if (interval_s == 0) {
+        return now;
+    }
+
+    uint32_t phase = send_schedule_phase_s(sensor_id, interval_s);
+    time_t next = (now - phase) / interval_s * interval_s + phase;
+    while (next <= now) {
+        next += interval_s;
+    }
+    return next + next_random() % SEND_JITTER_MAX_S;
+}
+
+uint32_t send_schedule_retry_delay_ms(int attempt, send_schedule_random_t next_random) {
+    uint32_t delay_ms = RETRY_BASE_DELAY_MS;
+    for (int i = 1; i < attempt && delay_ms < RETRY_MAX_DELAY_MS; i++) {
+        delay_ms *= 2;
+    }
+    if (delay_ms > RETRY_MAX_DELAY_MS) {
+        delay_ms = RETRY_MAX_DELAY_MS;
+    }
+    return delay_ms / 2 + next_random() % (delay_ms / 2 + 1);
+}
+
+uint32_t send_schedule_boot_delay_ms(bool power_on, send_schedule_random_t next_random) {
+    return power_on ? next_random() % BOOT_DELAY_MAX_MS : 0;
+}
@@ -14,19 +14,32 @@
 #include "app_config.h"
 #include "api_client.h"
 #include "adc_battery.h"
+#include "network_manager.h"
+#include "ntp.h"
+#include "pm_control.h"
+#include "sampling_scheduler.h"
+#include "send_schedule.h"
 #include "wifi_manager.h"
+#include "esp_attr.h"
 #include "esp_sleep.h"
 #include "esp_log.h"
+#include "esp_random.h"
+#include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #define TAG "STATUS_REPORTER"
 #define MAX_HTTP_RETRY_ATTEMPTS 3
-#define HTTP_RETRY_DELAY_MS 5000
+#define HOURLY_REPORT_INTERVAL_S (60 * 60)
 
 // Battery monitoring thresholds
 #define BATTERY_LOW_THRESHOLD_V     3.2       // Low battery warning threshold
 #define BATTERY_CRITICAL_THRESHOLD_V 3.0      // Critical battery threshold
 
+// Wall time of the last hourly report, kept across deep sleep so night and
+// duty-cycle sleeps don't restart the hour
+static RTC_DATA_ATTR time_t s_last_hourly_report = 0;
+
 void create_enhanced_status_message(const char* original_message, char* buffer, size_t buffer_size) {
     static bool first_boot_complete = false;
     esp_sleep_wakeup_cause_t wakeup_cause = esp_sleep_get_wakeup_cause();
@@ -156,11 +169,43 @@ bool send_status_update_with_retry(const char* status_message) {
         }
 
         if (attempt < MAX_HTTP_RETRY_ATTEMPTS) {
-            ESP_LOGI(TAG, "Waiting %d ms before retry...", HTTP_RETRY_DELAY_MS);
-            vTaskDelay(pdMS_TO_TICKS(HTTP_RETRY_DELAY_MS));
+            uint32_t delay_ms = send_schedule_retry_delay_ms(attempt, esp_random);
+            ESP_LOGI(TAG, "Waiting %lu ms before retry...", (unsigned long)delay_ms);
+            vTaskDelay(pdMS_TO_TICKS(delay_ms));
         }
     }
 
     ESP_LOGE(TAG, "Status update send failed after %d attempts", MAX_HTTP_RETRY_ATTEMPTS);
     return false;
-}
\ No newline at end of file
+}
+
+void send_hourly_report_if_due(void) {
+    if (!is_system_time_valid()) {
+        return;
+    }
+    time_t now = time(NULL);
+    if (s_last_hourly_report == 0 || now < s_last_hourly_report) {
+        // First valid clock, or it stepped back: the hour starts now
+        s_last_hourly_report = now;
+        return;
+    }
+    if (now - s_last_hourly_report < HOURLY_REPORT_INTERVAL_S) {
+        return;
+    }
+    s_last_hourly_report = now;
+
+    char report[192];
+    format_connectivity_report(report, sizeof(report));
+    ESP_LOGI(TAG, "Connectivity report: %s", report);
+    send_status_update_with_retry(report);
+
+    int sleep_percent = pm_control_log_stats();
+    if (sleep_percent >= 0) {
+        snprintf(report, sizeof(report), "pm light sleep %d%% since boot", sleep_percent);
+        send_status_update_with_retry(report);
+    }
+
+    sampling_scheduler_format_jitter(report, sizeof(report));
+    ESP_LOGI(TAG, "Jitter since boot: %s", report);
+    send_status_update_with_retry(report);
+}
@@ -0,0 +1,75 @@
+/**
+* @file sun_schedule.c
+ *
+ * Sunrise and sunset times from the NOAA solar position equations.
+ *
+ * Follows the NOAA Solar Calculator spreadsheet: solar declination and the
+ * equation of time are evaluated at approximate local solar noon, then the
+ * hour angle at the requested zenith gives sunrise and sunset either side of
+ * solar noon.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "sun_schedule.h"
+#include "tz_table.h"
+#include <math.h>
+
+#define DEG_TO_RAD (M_PI / 180.0)
+#define RAD_TO_DEG (180.0 / M_PI)
+#define JULIAN_DAY_UNIX_EPOCH 2440587.5
+#define JULIAN_DAY_J2000 2451545.0
+
+sun_day_type_t sun_schedule_compute(int year, int month, int day, double latitude, double longitude,
+                                    double zenith_deg, time_t *sunrise, time_t *sunset) {
+    int64_t day_number = tz_table_days_from_civil(year, month, day);
+
+    // Julian century at approximate local solar noon
+    double julian_day = JULIAN_DAY_UNIX_EPOCH + (double)day_number + 0.5 - longitude / 360.0;
+    double t = (julian_day - JULIAN_DAY_J2000) / 36525.0;
+
+    double mean_long = fmod(280.46646 + t * (36000.76983 + t * 0.0003032), 360.0);
+    double mean_anom = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+    double eccent = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+    double m_rad = mean_anom * DEG_TO_RAD;
+    double eq_center = sin(m_rad) * (1.914602 - t * (0.004817 + 0.000014 * t))
+                     + sin(2 * m_rad) * (0.019993 - 0.000101 * t)
+                     + sin(3 * m_rad) * 0.000289;
+    double true_long = mean_long + eq_center;
+    double omega = (125.04 - 1934.136 * t) * DEG_TO_RAD;
+    double app_long = (true_long - 0.00569 - 0.00478 * sin(omega)) * DEG_TO_RAD;
+
+    double mean_obliq = 23.0 + (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) / 60.0;
+    double obliq = (mean_obliq + 0.00256 * cos(omega)) * DEG_TO_RAD;
+    double declination = asin(sin(obliq) * sin(app_long));
+
+    double y = tan(obliq / 2) * tan(obliq / 2);
+    double l_rad = mean_long * DEG_TO_RAD;
+    double eq_time_min = 4.0 * RAD_TO_DEG * (y * sin(2 * l_rad)
+                                            - 2 * eccent * sin(m_rad)
+                                            + 4 * eccent * y * sin(m_rad) * cos(2 * l_rad)
+                                            - 0.5 * y * y * sin(4 * l_rad)
+                                            - 1.25 * eccent * eccent * sin(2 * m_rad));
+
+    double lat_rad = latitude * DEG_TO_RAD;
+    double cos_hour_angle = cos(zenith_deg * DEG_TO_RAD) / (cos(lat_rad) * cos(declination))
+                          - tan(lat_rad) * tan(declination);
+    if (cos_hour_angle > 1.0) {
+        return SUN_DAY_POLAR_NIGHT;
+    }
+    if (cos_hour_angle < -1.0) {
+        return SUN_DAY_MIDNIGHT_SUN;
+    }
+
+    double hour_angle_deg = acos(cos_hour_angle) * RAD_TO_DEG;
+    double solar_noon_min = 720.0 - 4.0 * longitude - eq_time_min;   // Minutes after UTC midnight
+    time_t midnight = (time_t)(day_number * 86400LL);
+
+    *sunrise = midnight + (time_t)lround((solar_noon_min - 4.0 * hour_angle_deg) * 60.0);
+    *sunset = midnight + (time_t)lround((solar_noon_min + 4.0 * hour_angle_deg) * 60.0);
+    return SUN_DAY_NORMAL;
+}
@@ -0,0 +1,82 @@
+/**
+* @file swinging_door.c
+ *
+ * Swinging door compression of a batch of readings before upload.
+ *
+ * Most readings in steady light are predictable from their neighbours. The
+ * swinging door algorithm keeps a pivot (the last kept reading) and the
+ * range of slopes from it that pass within the error bound of every reading
+ * since. While the line to a new reading stays inside that range, the
+ * readings in between can be dropped; once it falls outside, the reading
+ * before is kept and becomes the new pivot. Checking the line to an actual
+ * reading, rather than the open door alone, keeps the error within the bound
+ * instead of up to twice it. One pass, no extra memory, and
+ * the server can rebuild the series by interpolating between what arrives.
+ *
+ * This module has no ESP-IDF dependencies.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "swinging_door.h"
+#include <math.h>
+
+int swinging_door_compress(sensor_reading_t *readings, int count, float max_error_lux) {
+    if (max_error_lux <= 0.0f || count <= 2) {
+        return count;
+    }
+
+    // Kept readings are written at or before their own index, so reads of i and i - 1 are safe
+    int kept = 1;
+    int pivot = 0;
+    time_t pivot_t = readings[0].timestamp;
+    float pivot_lux = readings[0].lux;
+    float upper = INFINITY;
+    float lower = -INFINITY;
+
+    for (int i = 1; i < count; i++) {
+        sensor_reading_t previous = readings[i - 1];
+        sensor_reading_t reading = readings[i];
+
+        if (reading.timestamp <= previous.timestamp) {
+            // Timestamps went backwards: keep both sides of the break and start over
+            if (pivot != i - 1) {
+                readings[kept++] = previous;
+            }
+            readings[kept++] = reading;
+            pivot = i;
+            pivot_t = reading.timestamp;
+            pivot_lux = reading.lux;
+            upper = INFINITY;
+            lower = -INFINITY;
+            continue;
+        }
+
+        float dt = (float)(reading.timestamp - pivot_t);
+        float slope = (reading.lux - pivot_lux) / dt;
+        if (slope > upper || slope < lower) {
+            // Door closed: the line to this reading misses one in between, so
+            // the previous reading is kept and pivots the next door
+            readings[kept++] = previous;
+            pivot = i - 1;
+            pivot_t = previous.timestamp;
+            pivot_lux = previous.lux;
+            upper = INFINITY;
+            lower = -INFINITY;
+            dt = (float)(reading.timestamp - pivot_t);
+        }
+
+        // Later lines from the pivot must pass within the bound of this reading
+        upper = fminf(upper, (reading.lux + max_error_lux - pivot_lux) / dt);
+        lower = fmaxf(lower, (reading.lux - max_error_lux - pivot_lux) / dt);
+    }
+
+    if (pivot != count - 1) {
+        readings[kept++] = readings[count - 1];
+    }
+    return kept;
+}
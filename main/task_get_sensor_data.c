@@ -11,18 +11,56 @@
  */
 
 #include "task_get_sensor_data.h"
+#include "task_send_data.h"
 #include "app_context.h"
 #include "light_sensor.h"
 #include "esp_log.h"
 #include "persistent_storage.h"
+#include "data_processor.h"
+#include "ntp.h"
+#include "esp_timer.h"
+#include "generated_config.h"
 #include <string.h>
 #include <time.h>
 
+#include "adaptive_sampler.h"
 #include "internal_temp.h"
+#include "lux_stats.h"
+#include "reading_buffer.h"
+#include "sampling_scheduler.h"
 #include "time_utils.h"
 
 #define TAG "SENSOR_TASK"
-#define READING_INTERVAL_S 15
+
+/**
+ * @brief Take one light sub-sample into the running statistics
+ *
+ * @param context Application context with the light sensor
+ * @param stats Statistics for the reading in progress
+ * @param duration_s Time the sub-sample stands for, for the light integral
+ * @param chip_temp_c Chip temperature, read while the light sensor converts
+ * @return Result of the chip temperature read
+ */
+static esp_err_t take_subsample(app_context_t *context, lux_stats_t *stats, float duration_s, float *chip_temp_c) {
+    float lux = 0;
+
+    // The chip temperature is read while the light sensor converts
+    int64_t started_us = esp_timer_get_time();
+    uint32_t ready_in_ms = 0;
+    esp_err_t light_err = start_ambient_light(context->light_sensor_dev, &ready_in_ms);
+    esp_err_t temp_err = internal_temp_read(chip_temp_c);
+    if (light_err == ESP_OK) {
+        wait_for_ambient_light(started_us, ready_in_ms);
+        light_err = get_ambient_light(context->light_sensor_dev, &lux);
+    }
+
+    if (light_err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to get light reading: %s", esp_err_to_name(light_err));
+    } else {
+        lux_stats_add(stats, lux, duration_s);
+    }
+    return temp_err;
+}
 
 void task_get_sensor_data(void *arg) {
     app_context_t *context = (app_context_t *)arg;
@@ -30,35 +68,88 @@ void task_get_sensor_data(void *arg) {
     // Initialize internal temperature sensor
     internal_temp_init();
 
+    // Light sub-samples spread over each reading interval, reduced as they arrive
+    lux_stats_t stats;
+
+    // Reading interval between the configured bounds, shorter while the light changes
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, CONFIG_SAMPLE_INTERVAL_MIN_S, CONFIG_SAMPLE_INTERVAL_MAX_S);
+
     while (1) {
-        vTaskDelay(pdMS_TO_TICKS(READING_INTERVAL_S * 1000));
+        // Each reading lands on a wall-clock multiple of the interval, with its
+        // sub-samples evenly spaced over the interval before it
+        uint32_t interval_ms = adaptive_sampler_interval_ms(&sampler);
+        int64_t reading_ms = sampling_scheduler_next_boundary_ms(sampling_scheduler_now_ms(), interval_ms);
+        // Checked with the clock reading_ms came from: the first sync after power-on
+        // often lands during the waits below and would leave a 1970 stamp marked final
+        bool provisional = !is_system_time_valid();
+        float subsample_s = interval_ms / 1000.0f / CONFIG_LIGHT_SUBSAMPLES;
 
         if (is_nighttime_local()) {
+            adaptive_sampler_restart(&sampler);
+            sampling_scheduler_wait_until(reading_ms, interval_ms);
             continue;
         }
 
-        float lux = 0;
+        lux_stats_reset(&stats);
         float chip_temp_c = 0;
+        esp_err_t temp_err = ESP_FAIL;
+        for (int i = 1; i <= CONFIG_LIGHT_SUBSAMPLES; i++) {
+            int64_t subsample_ms = reading_ms - interval_ms + (int64_t)interval_ms * i / CONFIG_LIGHT_SUBSAMPLES;
+            // Sub-samples already past are skipped, so the first reading may be partial
+            if (sampling_scheduler_wait_until(subsample_ms, interval_ms) || i == CONFIG_LIGHT_SUBSAMPLES) {
+                temp_err = take_subsample(context, &stats, subsample_s, &chip_temp_c);
+            }
+        }
 
-        esp_err_t light_err = get_ambient_light(context->light_sensor_dev, &lux);
-        esp_err_t temp_err = internal_temp_read(&chip_temp_c);
+        // After the clock stepped back the reading would be stamped ahead of
+        // the new time; drop it and plan the next one from the corrected clock
+        if (sampling_scheduler_now_ms() < reading_ms - interval_ms) {
+            ESP_LOGW(TAG, "Clock stepped back during the reading - rescheduling");
+            continue;
+        }
 
-        if (light_err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to get light reading: %s", esp_err_to_name(light_err));
+        if (stats.count == 0) {
             continue;
         }
+        float lux = stats.mean;
+        time_utils_observe_lux(lux);
+
+        adaptive_sampler_update(&sampler, lux);
+        uint32_t next_interval_ms = adaptive_sampler_interval_ms(&sampler);
+        if (next_interval_ms != interval_ms) {
+            ESP_LOGI(TAG, "Reading interval %.1f s -> %.1f s", interval_ms / 1000.0f, next_interval_ms / 1000.0f);
+        }
 
-        time_t now;
-        time(&now);
+        // Stamped with the boundary it was scheduled for; provisional readings are rebased from mono_us
+        time_t now = (time_t)(reading_ms / 1000);
+        int64_t mono_us = esp_timer_get_time();
+
+        // The send task drains the buffer from the high-water mark on. If it is
+        // still full (a send stuck in a long connection attempt), spill it to
+        // flash instead of overwriting it; that costs a flash write, not a network wait.
+        bool buffer_full = false;
+        if (xSemaphoreTake(context->buffer_mutex, portMAX_DELAY) == pdTRUE) {
+            buffer_full = *(context->reading_idx) >= context->buffer_size;
+            xSemaphoreGive(context->buffer_mutex);
+        }
+        if (buffer_full) {
+            ESP_LOGW(TAG, "Reading buffer full - spilling it to persistent storage");
+            process_buffered_readings(context, save_readings_processor);
+        }
 
         if (xSemaphoreTake(context->buffer_mutex, portMAX_DELAY) == pdTRUE) {
             if (*(context->reading_idx) >= context->buffer_size) {
-                // Save buffer logic...
-                *(context->reading_idx) = 0;
+                ESP_LOGE(TAG, "Reading buffer could not be spilled - dropping this reading");
+                xSemaphoreGive(context->buffer_mutex);
+                continue;
             }
 
             context->reading_buffer[*(context->reading_idx)].timestamp = now;
-            context->reading_buffer[*(context->reading_idx)].lux = lux;
+            lux_stats_to_reading(&stats, &context->reading_buffer[*(context->reading_idx)]);
+            context->reading_buffer[*(context->reading_idx)].mono_us = mono_us;
+            context->reading_buffer[*(context->reading_idx)].boot_id = time_utils_get_boot_id();
+            context->reading_buffer[*(context->reading_idx)].provisional = provisional;
 
             if (temp_err == ESP_OK) {
                 context->reading_buffer[*(context->reading_idx)].chip_temp_c = chip_temp_c;
@@ -79,7 +170,14 @@ void task_get_sensor_data(void *arg) {
                          *(context->reading_idx), lux);
             }
 
+            // Only the reading that crosses the mark notifies, not every one after it
+            bool high_water = *(context->reading_idx) == reading_buffer_high_water_mark(context->buffer_size);
             xSemaphoreGive(context->buffer_mutex);
+
+            // Wake the send task now rather than at its next deadline
+            if (high_water && context->send_task_handle != NULL) {
+                xTaskNotify(context->send_task_handle, SEND_TASK_NOTIFY_HIGH_WATER, eSetBits);
+            }
         }
     }
 }
@@ -18,14 +18,37 @@
 #include "status_reporter.h"
 #include "time_utils.h"
 #include "power_management.h"
+#include "connectivity_backoff.h"
+#include "duty_cycle.h"
+#include "send_schedule.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
 #include "esp_log.h"
+#include "esp_random.h"
+#include "esp_system.h"
 #include <time.h>
 
 #define TAG "SEND_DATA_TASK"
 
 #define DATA_SEND_INTERVAL_MINUTES 5
 #define DATA_SEND_INTERVAL_S (DATA_SEND_INTERVAL_MINUTES * 60)
-#define TASK_LOOP_CHECK_INTERVAL_S 30
+
+// Kept across daytime deep sleep so upload wakes follow the normal sync interval
+static RTC_DATA_ATTR time_t s_last_ntp_sync_time = 0;
+
+/**
+ * @brief Get the monotonic time of this device's next send cycle
+ *
+ * The wall clock only picks the send time; the wait itself runs on esp_timer
+ * time, so a clock step during the wait doesn't move it.
+ *
+ * @return Deadline in esp_timer microseconds
+ */
+static int64_t next_send_deadline_us(void) {
+    time_t now = time(NULL);
+    time_t next_send_time = send_schedule_next_send_time(CONFIG_SENSOR_ID, now, DATA_SEND_INTERVAL_S, esp_random);
+    return esp_timer_get_time() + (int64_t)(next_send_time - now) * 1000000LL;
+}
 
 void task_send_data(void *arg) {
     app_context_t *context = (app_context_t *)arg;
@@ -39,16 +62,42 @@ void task_send_data(void *arg) {
         ESP_LOGW(TAG, "Continuing without persistent storage (degraded mode)");
     }
 
-    // Perform initial connection and time sync on startup
-    time_t last_ntp_sync_time = time(NULL);
+    // Perform initial connection and time sync on startup. Other than on an
+    // upload wake, the clock is synced right away.
+    bool upload_wake = duty_cycle_is_upload_wake();
+    if (!upload_wake) {
+        s_last_ntp_sync_time = 0;
+    }
+
+    // After a power cut the whole fleet boots at once; don't all connect at once too
+    if (!upload_wake) {
+        esp_reset_reason_t reason = esp_reset_reason();
+        uint32_t delay_ms = send_schedule_boot_delay_ms(reason == ESP_RST_POWERON || reason == ESP_RST_BROWNOUT,
+                                                        esp_random);
+        if (delay_ms > 0) {
+            ESP_LOGI(TAG, "Power-on reset - waiting %lu ms before the first connection", (unsigned long)delay_ms);
+            vTaskDelay(pdMS_TO_TICKS(delay_ms));
+        }
+    }
 
-    ESP_LOGI(TAG, "Starting initial network connection (attempt 1 of 15)");
-    if (initialize_network_connection(15)) {
+    // Upload and night wakes are full boots too, so the backoff has to gate this
+    // connection as well or a duty-cycled unit would scan on every upload wake
+    bool attempt_initial = connectivity_backoff_should_attempt();
+    bool initial_connected = false;
+    if (attempt_initial) {
+        int initial_budget = connectivity_backoff_get_attempt_budget();
+        ESP_LOGI(TAG, "Starting initial network connection (up to %d attempts)", initial_budget);
+        initial_connected = initialize_network_connection(initial_budget);
+        connectivity_backoff_record_result(initial_connected);
+    }
+    if (initial_connected) {
         ESP_LOGI(TAG, "WiFi connected successfully, performing initial setup");
 
-        // Send WiFi connection status (initial connection = true)
-        ESP_LOGI(TAG, "Sending WiFi connection status");
-        send_wifi_connection_status(true);
+        // Send WiFi connection status (initial connection = true), but not every few minutes
+        if (!upload_wake) {
+            ESP_LOGI(TAG, "Sending WiFi connection status");
+            send_wifi_connection_status(true);
+        }
 
         // Send device status
         ESP_LOGI(TAG, "Sending device status");
@@ -56,11 +105,15 @@ void task_send_data(void *arg) {
 
         // Perform initial NTP sync
         ESP_LOGI(TAG, "Performing initial NTP sync");
-        handle_ntp_sync(&last_ntp_sync_time, true);
+        handle_ntp_sync(&s_last_ntp_sync_time, !upload_wake);
+        apply_pending_time_correction(context);
+
+        // Readings taken while sleeping are the newest, so they go before the backlog
+        duty_cycle_flush_readings(true);
 
-        // Send any stored readings from previous sessions
+        // Start on any stored readings from previous sessions
         ESP_LOGI(TAG, "Checking for stored readings from previous sessions");
-        if (send_all_stored_readings()) {
+        if (backfill_stored_readings()) {
             ESP_LOGI(TAG, "Successfully processed stored readings");
         } else {
             ESP_LOGW(TAG, "Failed to process stored readings, will retry later");
@@ -68,101 +121,140 @@ void task_send_data(void *arg) {
 
         context->wifi_send_failed = false;
         ESP_LOGI(TAG, "Initial setup completed successfully");
-    } else {
+        disconnect_wifi_for_power_saving();
+    } else if (attempt_initial) {
         ESP_LOGE(TAG, "Failed to connect to WiFi for initial setup. Will retry in next cycle.");
+        disconnect_wifi_for_power_saving();
+        duty_cycle_flush_readings(false);
+        context->wifi_send_failed = true;
+    } else {
+        ESP_LOGI(TAG, "WiFi backoff active - skipping initial connection, radio stays off");
+        duty_cycle_flush_readings(false);
         context->wifi_send_failed = true;
     }
 
-    time_t last_send_time = time(NULL);
+    // On battery during the day, sleep between samples instead of running the loop below
+    duty_cycle_sleep_if_enabled(context);
+
+    int64_t deadline_us = next_send_deadline_us();
     int cycle_count = 0;
 
-    ESP_LOGI(TAG, "Entering main send loop (interval: %d minutes)", DATA_SEND_INTERVAL_MINUTES);
+    ESP_LOGI(TAG, "Entering main send loop (interval: %d minutes, phase: %lu s)", DATA_SEND_INTERVAL_MINUTES,
+             (unsigned long)send_schedule_phase_s(CONFIG_SENSOR_ID, DATA_SEND_INTERVAL_S));
 
     while (1) {
-        time_t now = time(NULL);
+        // Sleep until the send deadline or until the sensor task reports a filling buffer
+        uint32_t events = 0;
+        int64_t remaining_us = deadline_us - esp_timer_get_time();
+        if (remaining_us > 0) {
+            xTaskNotifyWait(0, UINT32_MAX, &events, pdMS_TO_TICKS((remaining_us + 999) / 1000) + 1);
+        }
+        if (events == 0 && esp_timer_get_time() < deadline_us) {
+            continue;
+        }
         cycle_count++;
 
-        ESP_LOGD(TAG, "Send loop cycle %d - checking if send time reached (last: %ld, now: %ld, diff: %ld)",
-                 cycle_count, last_send_time, now, now - last_send_time);
+        // Sent if connected, otherwise the failure path below saves the buffer to storage
+        if (events & SEND_TASK_NOTIFY_HIGH_WATER) {
+            ESP_LOGI(TAG, "Reading buffer past its high-water mark - draining early");
+        }
 
-        // Check if it's time to send data
-        if ((now - last_send_time) >= DATA_SEND_INTERVAL_S) {
-            ESP_LOGI(TAG, "=== DATA SEND CYCLE %d START === (heap: %zu bytes)",
-                     cycle_count, esp_get_free_heap_size());
-            log_local_time_status();
+        ESP_LOGI(TAG, "=== DATA SEND CYCLE %d START === (heap: %zu bytes)",
+                 cycle_count, esp_get_free_heap_size());
+        log_local_time_status();
 
-            if (is_nighttime_local()) {
-                ESP_LOGI(TAG, "Nighttime detected - evaluating power management options");
+        if (is_nighttime_local()) {
+            ESP_LOGI(TAG, "Nighttime detected - evaluating power management options");
 
-                if (should_enter_deep_sleep()) {
-                    ESP_LOGI(TAG, "Entering deep sleep mode");
-                    vTaskDelay(pdMS_TO_TICKS(2000));
-                    enter_night_sleep();
-                } else {
-                    ESP_LOGI(TAG, "Skipping data transmission for power savings (staying awake)");
-                    last_send_time = time(NULL);
-                    continue;
-                }
+            if (should_enter_deep_sleep()) {
+                ESP_LOGI(TAG, "Entering deep sleep mode");
+                vTaskDelay(pdMS_TO_TICKS(2000));
+                enter_night_sleep();
+            } else {
+                ESP_LOGI(TAG, "Skipping data transmission for power savings (staying awake)");
+                deadline_us = next_send_deadline_us();
+                continue;
             }
+        }
 
-            ESP_LOGI(TAG, "Data send interval reached. Connecting to WiFi...");
+        bool attempt_connection = connectivity_backoff_should_attempt();
+        bool connected = false;
 
-            if (initialize_network_connection(15)) {
-                ESP_LOGI(TAG, "Network connection established - proceeding with data operations");
+        if (attempt_connection) {
+            int budget = connectivity_backoff_get_attempt_budget();
+            ESP_LOGI(TAG, "Data send interval reached. Connecting to WiFi (up to %d attempts)...", budget);
+            connected = initialize_network_connection(budget);
+            connectivity_backoff_record_result(connected);
+        }
+
+        if (connected) {
+            ESP_LOGI(TAG, "Network connection established - proceeding with data operations");
 
-                // Handle NTP synchronization
-                ESP_LOGI(TAG, "Checking NTP synchronization requirements");
-                handle_ntp_sync(&last_ntp_sync_time, false);
+            // Handle NTP synchronization
+            ESP_LOGI(TAG, "Checking NTP synchronization requirements");
+            handle_ntp_sync(&s_last_ntp_sync_time, false);
+            apply_pending_time_correction(context);
 
-                // Send device status update
-                ESP_LOGI(TAG, "Sending device status update");
-                send_device_status_if_appropriate();
+            // Send device status update
+            ESP_LOGI(TAG, "Sending device status update");
+            send_device_status_if_appropriate();
+            send_hourly_report_if_due();
 
-                // Send any stored readings first if previous send failed
-                if (context->wifi_send_failed) {
-                    ESP_LOGI(TAG, "Previous send failed, attempting to send stored readings first");
-                    if (send_all_stored_readings()) {
-                        ESP_LOGI(TAG, "Successfully sent stored readings");
-                    } else {
-                        ESP_LOGW(TAG, "Failed to send stored readings");
-                    }
+            // Send current buffered readings
+            bool send_success = true;
+            if (*(context->reading_idx) > 0) {
+                ESP_LOGI(TAG, "Processing %d buffered readings", *(context->reading_idx));
+                // Readings that don't go out are saved for backfill instead of dropped
+                send_success = process_buffered_readings(context, send_or_save_readings_processor);
+                if (send_success) {
+                    ESP_LOGI(TAG, "Successfully processed buffered readings");
+                } else {
+                    ESP_LOGE(TAG, "Failed to process buffered readings");
                 }
+            } else {
+                ESP_LOGI(TAG, "No new readings to send.");
+            }
+
+            context->wifi_send_failed = !send_success;
 
-                // Send current buffered readings
-                bool send_success = true;
-                if (*(context->reading_idx) > 0) {
-                    ESP_LOGI(TAG, "Processing %d buffered readings", *(context->reading_idx));
-                    send_success = process_buffered_readings(context, send_readings_processor);
-                    if (send_success) {
-                        ESP_LOGI(TAG, "Successfully processed buffered readings");
-                    } else {
-                        ESP_LOGE(TAG, "Failed to process buffered readings");
-                    }
+            // Then a bounded slice of the backlog, newest first, so dashboards are current
+            // right after an outage while the history fills in over the following cycles
+            if (send_success && has_stored_readings()) {
+                ESP_LOGI(TAG, "Stored readings pending, backfilling");
+                if (backfill_stored_readings()) {
+                    ESP_LOGI(TAG, "Backfill slice sent");
                 } else {
-                    ESP_LOGI(TAG, "No new readings to send.");
+                    ESP_LOGW(TAG, "Failed to send stored readings");
                 }
+            }
 
-                context->wifi_send_failed = !send_success;
+            ESP_LOGI(TAG, "Disconnecting WiFi for power savings");
+            disconnect_wifi_for_power_saving();
 
-                ESP_LOGI(TAG, "Disconnecting WiFi for power savings");
+        } else {
+            if (attempt_connection) {
+                ESP_LOGE(TAG, "Failed to connect to WiFi - stopping radio until the next attempt");
                 disconnect_wifi_for_power_saving();
-
             } else {
-                ESP_LOGE(TAG, "Failed to connect to WiFi. Will retry in %d minutes.", DATA_SEND_INTERVAL_MINUTES);
-                context->wifi_send_failed = true;
-
-                // Save current readings to persistent storage
-                if (*(context->reading_idx) > 0) {
-                    ESP_LOGI(TAG, "Saving %d readings to persistent storage due to WiFi failure",
-                             *(context->reading_idx));
-                    process_buffered_readings(context, save_readings_processor);
-                }
+                ESP_LOGI(TAG, "WiFi backoff active - skipping connection attempt this cycle");
+            }
+            context->wifi_send_failed = true;
+
+            // Save current readings to persistent storage
+            if (*(context->reading_idx) > 0) {
+                ESP_LOGI(TAG, "Saving %d readings to persistent storage due to WiFi failure",
+                         *(context->reading_idx));
+                process_buffered_readings(context, save_readings_processor);
             }
-            last_send_time = time(NULL);
-            ESP_LOGI(TAG, "=== DATA SEND CYCLE %d END ===", cycle_count);
         }
+        deadline_us = next_send_deadline_us();
+
+        // A high-water notice raised while this cycle was draining the buffer is
+        // already handled; don't let it start a second connection right away
+        xTaskNotifyWait(0, UINT32_MAX, NULL, 0);
+        ESP_LOGI(TAG, "=== DATA SEND CYCLE %d END ===", cycle_count);
 
-        ESP_LOGD(TAG, "Sleeping for %d seconds (cycle %d)", TASK_LOOP_CHECK_INTERVAL_S, cycle_count);
-        vTaskDelay(pdMS_TO_TICKS(TASK_LOOP_CHECK_INTERVAL_S * 1000));
+        // Switch to sleeping between samples once the clock is valid and it is day
+        duty_cycle_sleep_if_enabled(context);
     }
-}
\ No newline at end of file
+}
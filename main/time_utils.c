@@ -12,44 +12,175 @@
 
 #include "time_utils.h"
 #include "app_config.h"
+#include "esp_random.h"
+#include "tz_table.h"
+#include "sun_schedule.h"
+#include "ntp.h"
+#include "esp_attr.h"
+#include <stdio.h>
 #include <time.h>
 #include <esp_log.h>
 
 #define TAG "TIME_UTILS"
 
-// Wake up every 30 minutes during night to check if it's time to resume
+// Without a valid clock, wake up every 30 minutes during night to check if it's time to resume
 #define NIGHT_CHECK_INTERVAL_US (30 * 60 * 1000000ULL)  // 30 minutes in microseconds
 
+#define DARK_WINDOW_S (2 * 60 * 60)     // Observed darkness may start the night up to 2 h before sunset
+#define DARK_CONFIRM_READINGS 4         // Consecutive dark readings needed (1 minute at 15 s)
+
+static uint32_t s_boot_id = 0;
+
+#if CONFIG_HAS_LOCATION
+/**
+ * @brief Evening darkness seen by the light sensor, kept across deep sleep
+ */
+typedef struct {
+    int64_t dark_day;                   // Local day number on which darkness was confirmed
+    uint8_t dark_count;                 // Consecutive dark readings so far
+} observed_dark_t;
+
+static RTC_DATA_ATTR observed_dark_t s_observed_dark = { .dark_day = -1 };
+
+/**
+ * @brief Day/night state at an instant, from sunrise and sunset at the configured location
+ */
+typedef struct {
+    bool is_night;
+    time_t next_change;                 // When is_night next flips (or should be re-evaluated)
+    sun_day_type_t day_type;
+    time_t sunrise;                     // Today's, only for SUN_DAY_NORMAL
+    time_t sunset;
+} sun_state_t;
+
+/**
+ * @brief Local day number (days since 1970-01-01 in local time) and its date
+ */
+static int64_t local_day_number(time_t now, struct tm *local_date) {
+    time_t local = now + tz_table_utc_offset(now, NULL);
+    int64_t day = local / 86400;
+    if (local % 86400 < 0) {
+        day--;
+    }
+    if (local_date != NULL) {
+        time_t midnight = (time_t)(day * 86400);
+        gmtime_r(&midnight, local_date);
+    }
+    return day;
+}
+
+/**
+ * @brief Sunrise/sunset for a local day, widened by the configured margin
+ */
+static sun_day_type_t daylight_for_day(int64_t day, time_t *day_start, time_t *day_end) {
+    time_t midnight = (time_t)(day * 86400);
+    struct tm date;
+    gmtime_r(&midnight, &date);
+
+    sun_day_type_t type = sun_schedule_compute(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday,
+                                               CONFIG_LATITUDE, CONFIG_LONGITUDE,
+                                               SUN_ZENITH_OFFICIAL, day_start, day_end);
+    if (type == SUN_DAY_NORMAL) {
+        *day_start -= CONFIG_SUN_MARGIN_MINUTES * 60;
+        *day_end += CONFIG_SUN_MARGIN_MINUTES * 60;
+    }
+    return type;
+}
+
+static void get_sun_state(time_t now, sun_state_t *state) {
+    int64_t today = local_day_number(now, NULL);
+    // Start of the next local day, for re-evaluating polar days
+    time_t next_midnight = (time_t)((today + 1) * 86400) - tz_table_utc_offset(now, NULL);
+
+    state->day_type = daylight_for_day(today, &state->sunrise, &state->sunset);
+    if (state->day_type != SUN_DAY_NORMAL) {
+        state->sunrise = 0;
+        state->sunset = 0;
+        state->is_night = (state->day_type == SUN_DAY_POLAR_NIGHT);
+        state->next_change = next_midnight;
+        return;
+    }
+
+    if (now < state->sunrise) {
+        state->is_night = true;
+        state->next_change = state->sunrise;
+        return;
+    }
+
+    bool dark_early = s_observed_dark.dark_day == today && now >= state->sunset - DARK_WINDOW_S;
+    if (now < state->sunset && !dark_early) {
+        state->is_night = false;
+        state->next_change = state->sunset;
+        return;
+    }
+
+    // After sunset: night until tomorrow's sunrise
+    time_t tomorrow_start, tomorrow_end;
+    state->is_night = true;
+    state->next_change = daylight_for_day(today + 1, &tomorrow_start, &tomorrow_end) == SUN_DAY_NORMAL
+                         ? tomorrow_start : next_midnight;
+}
+#endif
+
+void time_utils_observe_lux(float lux) {
+#if CONFIG_HAS_LOCATION
+    if (CONFIG_DARK_LUX_THRESHOLD <= 0 || !is_system_time_valid()) {
+        return;
+    }
+
+    time_t now = time(NULL);
+    sun_state_t state;
+    get_sun_state(now, &state);
+    if (state.is_night || state.day_type != SUN_DAY_NORMAL || now < state.sunset - DARK_WINDOW_S) {
+        s_observed_dark.dark_count = 0;
+        return;
+    }
+
+    if (lux >= CONFIG_DARK_LUX_THRESHOLD) {
+        s_observed_dark.dark_count = 0;
+        return;
+    }
+    if (++s_observed_dark.dark_count >= DARK_CONFIRM_READINGS) {
+        s_observed_dark.dark_day = local_day_number(now, NULL);
+        ESP_LOGI(TAG, "Darkness observed %lld minutes before sunset - starting night early",
+                 (long long)(state.sunset - now) / 60);
+    }
+#else
+    (void)lux;
+#endif
+}
+
+void time_utils_init(void) {
+    // Zero is reserved for readings that predate boot IDs
+    do {
+        s_boot_id = esp_random();
+    } while (s_boot_id == 0);
+
+    tz_table_init(CONFIG_LOCAL_TIMEZONE);
+}
+
+uint32_t time_utils_get_boot_id(void) {
+    return s_boot_id;
+}
+
 /**
- * @brief Execute a function with local timezone temporarily set
+ * @brief Execute a function with the current time in the local timezone
  *
- * This helper function temporarily switches to the configured local timezone,
- * gets the current time, calls the provided callback function with local time
- * data, then restores the original timezone. This centralizes the repetitive
- * timezone save/restore pattern used throughout the application.
+ * Gets the current time, converts it with the cached timezone table built by
+ * time_utils_init(), and calls the provided callback function with the local
+ * time data. The process TZ variable is never touched, so this is safe to call
+ * from several tasks at once.
  *
- * @param func Callback function to execute with local timezone active
+ * @param func Callback function to execute with local time
  * @param user_data Optional data pointer passed to the callback function
  */
 void with_local_timezone(void (*func)(const struct tm*, time_t, void*), void* user_data) {
-    char* old_tz = getenv("TZ");
-    setenv("TZ", CONFIG_LOCAL_TIMEZONE, 1);
-    tzset();
-
     time_t now;
     time(&now);
     struct tm local_time;
-    localtime_r(&now, &local_time);
+    tz_table_utc_to_local(now, &local_time);
 
     func(&local_time, now, user_data);
-
-    // Restore timezone
-    if (old_tz) {
-        setenv("TZ", old_tz, 1);
-    } else {
-        unsetenv("TZ");
-    }
-    tzset();
 }
 
 /**
@@ -87,6 +218,29 @@ static void check_nighttime_callback(const struct tm* local_time, time_t now, vo
  * Example output: "Local time: 2025-01-15 14:30:15 (22:00-04:00) - DAY (active)"
  */
 static void log_time_status_callback(const struct tm* local_time, time_t now, void* user_data) {
+#if CONFIG_HAS_LOCATION
+    if (is_system_time_valid()) {
+        sun_state_t state;
+        get_sun_state(now, &state);
+        char daylight[24];
+        if (state.day_type == SUN_DAY_NORMAL) {
+            struct tm rise_tm, set_tm;
+            tz_table_utc_to_local(state.sunrise, &rise_tm);
+            tz_table_utc_to_local(state.sunset, &set_tm);
+            snprintf(daylight, sizeof(daylight), "daylight %02d:%02d-%02d:%02d",
+                     rise_tm.tm_hour, rise_tm.tm_min, set_tm.tm_hour, set_tm.tm_min);
+        } else {
+            snprintf(daylight, sizeof(daylight), "%s",
+                     state.day_type == SUN_DAY_POLAR_NIGHT ? "polar night" : "midnight sun");
+        }
+
+        ESP_LOGI(TAG, "Local time: %04d-%02d-%02d %02d:%02d:%02d (%s) - %s",
+                 local_time->tm_year + 1900, local_time->tm_mon + 1, local_time->tm_mday,
+                 local_time->tm_hour, local_time->tm_min, local_time->tm_sec,
+                 daylight, state.is_night ? "NIGHT (power save)" : "DAY (active)");
+        return;
+    }
+#endif
     bool is_night = (local_time->tm_hour >= CONFIG_NIGHT_START_HOUR ||
                      local_time->tm_hour < CONFIG_NIGHT_END_HOUR);
     const char* status = is_night ? "NIGHT (power save)" : "DAY (active)";
@@ -101,7 +255,8 @@ static void log_time_status_callback(const struct tm* local_time, time_t now, vo
  * @brief Callback function to calculate sleep duration
  *
  * Used by calculate_night_sleep_duration_us() to calculate how long to sleep
- * until the end of the night period, capped at the check interval.
+ * until the end of the night period. Capped at the check interval only while
+ * the clock is not set.
  *
  * @param local_time Current time in local timezone
  * @param now Current timestamp (unused)
@@ -119,21 +274,18 @@ static void calculate_sleep_callback(const struct tm* local_time, time_t now, vo
         return;
     }
 
-    // Calculate minutes until wake time
-    int minutes_until_wake;
-
-    if (current_hour >= CONFIG_NIGHT_START_HOUR) {
-        // After night start hour, sleep until end hour next day
-        minutes_until_wake = (24 - current_hour) * 60 - current_min + (CONFIG_NIGHT_END_HOUR * 60);
-    } else {
-        // Before end hour, sleep until end hour today
-        minutes_until_wake = (CONFIG_NIGHT_END_HOUR * 60) - (current_hour * 60 + current_min);
-    }
+    // Local wall time of the night end, today or tomorrow, converted back to UTC
+    // through the timezone table so a DST change overnight doesn't move the wake by an hour
+    time_t local_midnight = now + tz_table_utc_offset(now, NULL)
+                          - (current_hour * 3600 + current_min * 60 + local_time->tm_sec);
+    time_t local_wake = local_midnight + CONFIG_NIGHT_END_HOUR * 3600
+                      + (current_hour >= CONFIG_NIGHT_START_HOUR ? 86400 : 0);
+    time_t wake = local_wake - tz_table_utc_offset(local_wake - tz_table_utc_offset(now, NULL), NULL);
 
-    // Convert to microseconds, but cap at our check interval
-    *sleep_duration = (uint64_t)minutes_until_wake * 60 * 1000000ULL;
+    *sleep_duration = wake > now ? (uint64_t)(wake - now) * 1000000ULL : 0;
 
-    if (*sleep_duration > NIGHT_CHECK_INTERVAL_US) {
+    // Sleep straight through to the wake time; only an unset clock needs periodic check-ins
+    if (!is_system_time_valid() && *sleep_duration > NIGHT_CHECK_INTERVAL_US) {
         *sleep_duration = NIGHT_CHECK_INTERVAL_US;
     }
 
@@ -150,9 +302,19 @@ static void calculate_sleep_callback(const struct tm* local_time, time_t now, vo
  * @return false if current local time is during daytime hours
  */
 bool is_nighttime_local(void) {
+#if CONFIG_HAS_LOCATION
+    // Without a valid clock the sun position is meaningless; keep sampling
+    if (!is_system_time_valid()) {
+        return false;
+    }
+    sun_state_t state;
+    get_sun_state(time(NULL), &state);
+    return state.is_night;
+#else
     bool is_night = false;
     with_local_timezone(check_nighttime_callback, &is_night);
     return is_night;
+#endif
 }
 
 /**
@@ -171,7 +333,22 @@ void log_local_time_status(void) {
  * @return Sleep duration in microseconds, or 0 if not nighttime
  */
 uint64_t calculate_night_sleep_duration_us(void) {
+#if CONFIG_HAS_LOCATION
+    if (!is_system_time_valid()) {
+        return 0;
+    }
+    time_t now = time(NULL);
+    sun_state_t state;
+    get_sun_state(now, &state);
+    if (!state.is_night) {
+        return 0;
+    }
+    uint64_t sun_sleep_us = (uint64_t)(state.next_change - now) * 1000000ULL;
+    ESP_LOGI(TAG, "Calculated sleep duration: %llu minutes", sun_sleep_us / (60 * 1000000ULL));
+    return sun_sleep_us;
+#else
     uint64_t sleep_duration = 0;
     with_local_timezone(calculate_sleep_callback, &sleep_duration);
     return sleep_duration;
+#endif
 }
\ No newline at end of file
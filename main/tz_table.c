@@ -0,0 +1,312 @@
+/**
+* @file tz_table.c
+ *
+ * Precomputed UTC offset and DST transition table built from a POSIX TZ string.
+ *
+ * The configured zone is parsed once at startup and its DST transitions are
+ * expanded for a range of years into a sorted table. Looking up local time is
+ * then a binary search over read-only data, instead of swapping the process
+ * TZ variable and re-running tzset() on every call. Years outside the table
+ * are computed from the parsed rules directly.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "tz_table.h"
+#include "esp_log.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "TZ_TABLE"
+
+#define TZ_TABLE_FIRST_YEAR 2020
+#define TZ_TABLE_YEARS 50
+#define TZ_TABLE_MAX_TRANSITIONS (TZ_TABLE_YEARS * 2)
+#define SECONDS_PER_DAY 86400LL
+
+/**
+ * @brief When in the year a DST change happens
+ */
+typedef enum {
+    TZ_RULE_MONTH_WEEK_DAY,     // Mm.w.d: day d of week w of month m (w = 5 means last)
+    TZ_RULE_JULIAN_NO_LEAP,     // Jn: day 1-365, February 29 is never counted
+    TZ_RULE_DAY_OF_YEAR         // n: zero-based day 0-365, February 29 is counted
+} tz_rule_type_t;
+
+typedef struct {
+    tz_rule_type_t type;
+    int month;
+    int week;
+    int day;                    // Weekday for Mm.w.d, day number otherwise
+    int32_t time_s;             // Local wall time of the change, may be negative or over 24 h
+} tz_rule_t;
+
+typedef struct {
+    time_t utc;                 // Instant of the change
+    int32_t offset_s;           // Offset east of UTC from this instant on
+    bool is_dst;
+} tz_transition_t;
+
+typedef struct {
+    int32_t std_offset_s;       // East of UTC
+    int32_t dst_offset_s;
+    bool has_dst;
+    tz_rule_t start;            // Change to DST, given in standard time
+    tz_rule_t end;              // Change back, given in DST
+} tz_zone_t;
+
+static tz_zone_t s_zone;
+static tz_transition_t s_transitions[TZ_TABLE_MAX_TRANSITIONS];
+static int s_transition_count = 0;
+
+int64_t tz_table_days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int64_t)era * 146097 + doe - 719468;
+}
+
+static bool is_leap_year(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int days_in_month(int year, int month) {
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && is_leap_year(year)) ? 29 : days[month - 1];
+}
+
+/**
+ * @brief Parse a zone name: alphabetic, or any characters inside <...>
+ */
+static const char* parse_name(const char *p) {
+    if (*p == '<') {
+        const char *close = strchr(p, '>');
+        return close != NULL ? close + 1 : NULL;
+    }
+    const char *start = p;
+    while (isalpha((unsigned char)*p)) {
+        p++;
+    }
+    return (p - start >= 3) ? p : NULL;
+}
+
+/**
+ * @brief Parse [+|-]hh[:mm[:ss]] into seconds
+ */
+static const char* parse_hms(const char *p, int32_t *seconds) {
+    int sign = 1;
+    if (*p == '+' || *p == '-') {
+        sign = (*p == '-') ? -1 : 1;
+        p++;
+    }
+    if (!isdigit((unsigned char)*p)) {
+        return NULL;
+    }
+
+    char *end;
+    long hours = strtol(p, &end, 10);
+    long minutes = 0;
+    long secs = 0;
+    p = end;
+    if (*p == ':') {
+        minutes = strtol(p + 1, &end, 10);
+        p = end;
+        if (*p == ':') {
+            secs = strtol(p + 1, &end, 10);
+            p = end;
+        }
+    }
+    if (hours > 167 || minutes > 59 || secs > 59) {
+        return NULL;
+    }
+    *seconds = sign * (int32_t)(hours * 3600 + minutes * 60 + secs);
+    return p;
+}
+
+/**
+ * @brief Parse one transition rule, with the optional /time suffix
+ */
+static const char* parse_rule(const char *p, tz_rule_t *rule) {
+    char *end;
+    if (*p == 'M') {
+        rule->type = TZ_RULE_MONTH_WEEK_DAY;
+        rule->month = strtol(p + 1, &end, 10);
+        if (*end != '.') return NULL;
+        rule->week = strtol(end + 1, &end, 10);
+        if (*end != '.') return NULL;
+        rule->day = strtol(end + 1, &end, 10);
+        if (rule->month < 1 || rule->month > 12 || rule->week < 1 || rule->week > 5 ||
+            rule->day < 0 || rule->day > 6) {
+            return NULL;
+        }
+    } else if (*p == 'J') {
+        rule->type = TZ_RULE_JULIAN_NO_LEAP;
+        rule->day = strtol(p + 1, &end, 10);
+        if (end == p + 1 || rule->day < 1 || rule->day > 365) return NULL;
+    } else if (isdigit((unsigned char)*p)) {
+        rule->type = TZ_RULE_DAY_OF_YEAR;
+        rule->day = strtol(p, &end, 10);
+        if (rule->day > 365) return NULL;
+    } else {
+        return NULL;
+    }
+    p = end;
+
+    rule->time_s = 2 * 3600;    // POSIX default
+    if (*p == '/') {
+        p = parse_hms(p + 1, &rule->time_s);
+    }
+    return p;
+}
+
+/**
+ * @brief Local midnight (as seconds since epoch, no offset applied) of the rule's day
+ */
+static int64_t rule_day_start(const tz_rule_t *rule, int year) {
+    int64_t jan1 = tz_table_days_from_civil(year, 1, 1);
+    switch (rule->type) {
+    case TZ_RULE_JULIAN_NO_LEAP: {
+        int64_t day = jan1 + rule->day - 1;
+        if (is_leap_year(year) && rule->day >= 60) {
+            day++;
+        }
+        return day * SECONDS_PER_DAY;
+    }
+    case TZ_RULE_DAY_OF_YEAR:
+        return (jan1 + rule->day) * SECONDS_PER_DAY;
+    case TZ_RULE_MONTH_WEEK_DAY:
+    default: {
+        int64_t first = tz_table_days_from_civil(year, rule->month, 1);
+        int first_weekday = (int)(((first % 7) + 7 + 4) % 7);   // 1970-01-01 was a Thursday
+        int mday = 1 + (rule->day - first_weekday + 7) % 7 + (rule->week - 1) * 7;
+        while (mday > days_in_month(year, rule->month)) {
+            mday -= 7;
+        }
+        return (first + mday - 1) * SECONDS_PER_DAY;
+    }
+    }
+}
+
+/**
+ * @brief UTC instants of the year's DST start and end
+ */
+static void year_transitions(int year, time_t *dst_start, time_t *dst_end) {
+    *dst_start = (time_t)(rule_day_start(&s_zone.start, year) + s_zone.start.time_s - s_zone.std_offset_s);
+    *dst_end = (time_t)(rule_day_start(&s_zone.end, year) + s_zone.end.time_s - s_zone.dst_offset_s);
+}
+
+static bool parse_posix_tz(const char *tz, tz_zone_t *zone) {
+    memset(zone, 0, sizeof(*zone));
+    const char *p = parse_name(tz);
+    int32_t west_s;
+    if (p == NULL || (p = parse_hms(p, &west_s)) == NULL) {
+        return false;
+    }
+    zone->std_offset_s = -west_s;   // POSIX offsets count west of UTC
+    zone->dst_offset_s = zone->std_offset_s;
+
+    if (*p == '\0') {
+        return true;
+    }
+
+    p = parse_name(p);
+    if (p == NULL) {
+        return false;
+    }
+    zone->has_dst = true;
+    zone->dst_offset_s = zone->std_offset_s + 3600;
+    if (*p != ',' && *p != '\0') {
+        if ((p = parse_hms(p, &west_s)) == NULL) {
+            return false;
+        }
+        zone->dst_offset_s = -west_s;
+    }
+
+    if (*p == '\0') {
+        // No rules given: use the current US rules, as newlib does
+        zone->start = (tz_rule_t){ TZ_RULE_MONTH_WEEK_DAY, 3, 2, 0, 2 * 3600 };
+        zone->end = (tz_rule_t){ TZ_RULE_MONTH_WEEK_DAY, 11, 1, 0, 2 * 3600 };
+        return true;
+    }
+    if (*p != ',' || (p = parse_rule(p + 1, &zone->start)) == NULL) {
+        return false;
+    }
+    if (*p != ',' || (p = parse_rule(p + 1, &zone->end)) == NULL) {
+        return false;
+    }
+    return *p == '\0';
+}
+
+bool tz_table_init(const char *posix_tz) {
+    s_transition_count = 0;
+    if (posix_tz == NULL || !parse_posix_tz(posix_tz, &s_zone)) {
+        ESP_LOGE(TAG, "Invalid timezone '%s' - using UTC", posix_tz ? posix_tz : "(null)");
+        memset(&s_zone, 0, sizeof(s_zone));
+        return false;
+    }
+
+    if (s_zone.has_dst) {
+        for (int year = TZ_TABLE_FIRST_YEAR; year < TZ_TABLE_FIRST_YEAR + TZ_TABLE_YEARS; year++) {
+            time_t start, end;
+            year_transitions(year, &start, &end);
+            tz_transition_t to_dst = { start, s_zone.dst_offset_s, true };
+            tz_transition_t to_std = { end, s_zone.std_offset_s, false };
+            // Southern hemisphere zones end DST before they start it
+            s_transitions[s_transition_count++] = start < end ? to_dst : to_std;
+            s_transitions[s_transition_count++] = start < end ? to_std : to_dst;
+        }
+    }
+
+    ESP_LOGI(TAG, "Timezone '%s': UTC%+ld, DST %s, %d transitions cached",
+             posix_tz, (long)s_zone.std_offset_s / 3600, s_zone.has_dst ? "yes" : "no",
+             s_transition_count);
+    return true;
+}
+
+int32_t tz_table_utc_offset(time_t utc, bool *is_dst) {
+    bool dst = false;
+
+    if (s_zone.has_dst) {
+        if (s_transition_count > 0 && utc >= s_transitions[0].utc &&
+            utc < s_transitions[s_transition_count - 1].utc) {
+            // Last transition at or before utc
+            int lo = 0;
+            int hi = s_transition_count - 1;
+            while (lo < hi) {
+                int mid = (lo + hi + 1) / 2;
+                if (s_transitions[mid].utc <= utc) {
+                    lo = mid;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+            dst = s_transitions[lo].is_dst;
+        } else {
+            // Outside the cached years: evaluate the rules for the year directly
+            struct tm utc_tm;
+            gmtime_r(&utc, &utc_tm);
+            time_t start, end;
+            year_transitions(utc_tm.tm_year + 1900, &start, &end);
+            dst = start < end ? (utc >= start && utc < end) : (utc >= start || utc < end);
+        }
+    }
+
+    if (is_dst != NULL) {
+        *is_dst = dst;
+    }
+    return dst ? s_zone.dst_offset_s : s_zone.std_offset_s;
+}
+
+void tz_table_utc_to_local(time_t utc, struct tm *local_time) {
+    bool is_dst;
+    time_t shifted = utc + tz_table_utc_offset(utc, &is_dst);
+    gmtime_r(&shifted, local_time);
+    local_time->tm_isdst = is_dst ? 1 : 0;
+}
@@ -16,7 +16,10 @@
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_netif.h"
+#include "esp_attr.h"
+#include "nvs.h"
 #include "wifi_manager.h"
+#include "wifi_tx_power.h"
 #include "sdkconfig.h"
 #include <stdbool.h>
 
@@ -24,6 +27,12 @@
 
 #define MAX_WIFI_NETWORKS 5
 #define MAX_RECONNECT_RETRIES 3
+#define MAX_SCAN_RECORDS 20
+#define SCAN_ACTIVE_MIN_MS 30            // Per-channel dwell time for the ranking scan
+#define SCAN_ACTIVE_MAX_MS 80
+#define LAST_GOOD_RSSI_BONUS_DB 10       // Stick with the last-known-good AP unless another is clearly stronger
+#define NVS_NAMESPACE "wifi_mgr"
+#define KEY_LAST_GOOD "last_good"
 
 static const char* wifi_reason_to_str(uint8_t reason)
 {
@@ -134,15 +143,57 @@ typedef struct
     char password[64];
 } wifi_network_t;
 
+/**
+ * @brief Per-network connection statistics, kept in RTC memory so they survive deep sleep
+ */
+typedef struct
+{
+    uint16_t attempts;    // Connection sequences started on this network
+    uint16_t successes;   // Sequences that ended with an IP address
+    uint16_t first_try;   // Successes on the very first association attempt of a cycle
+    int8_t last_rssi;     // RSSI from the most recent scan, 0 if not seen
+} wifi_network_stats_t;
+
+/**
+ * @brief What the most recent scan told us about a configured network
+ */
+typedef struct
+{
+    bool seen;
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t bssid[6];
+} wifi_scan_hint_t;
+
 static wifi_network_t s_wifi_networks[MAX_WIFI_NETWORKS];
 static int s_num_networks = 0;
 static int s_current_network_index = 0;
 static int s_reconnect_retries = 0;
 static bool s_is_connected = false;
 static bool s_is_initialized = false;
-
-// Forward declaration
+static bool s_stop_requested = false;
+static bool s_power_save = false;
+static bool s_idle = false;         // Association parked between sends (stay mode)
+static uint16_t s_listen_interval = 0;
+
+// Ranked connection order for the current cycle, rebuilt after every scan
+static int s_connect_order[MAX_WIFI_NETWORKS];
+static int s_connect_order_pos = 0;
+static wifi_scan_hint_t s_scan_hints[MAX_WIFI_NETWORKS];
+static bool s_scan_valid = false;
+static bool s_scan_in_progress = false;
+static int s_cycle_attempts = 0;
+
+static RTC_DATA_ATTR wifi_network_stats_t s_network_stats[MAX_WIFI_NETWORKS];
+static RTC_DATA_ATTR int8_t s_last_good_index = -1;
+
+// Forward declarations
 static void try_to_connect(void);
+static esp_err_t start_network_scan(void);
+static void collect_scan_results(void);
+static void rank_networks(void);
+static void load_last_good_network(void);
+static void record_connection_success(void);
 
 static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
 {
@@ -152,8 +203,25 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START)
     {
         ESP_LOGI(TAG, "WiFi stack started - beginning connection sequence");
+        s_scan_valid = false;
+
+        // With a single network there is nothing to rank, so skip the scan
+        if (s_num_networks > 1 && start_network_scan() == ESP_OK) {
+            return; // Connection continues from WIFI_EVENT_SCAN_DONE
+        }
+        rank_networks();
         try_to_connect(); // Start connection attempts when WiFi stack is ready
     }
+    else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_SCAN_DONE)
+    {
+        if (!s_scan_in_progress) {
+            return;
+        }
+        s_scan_in_progress = false;
+        collect_scan_results();
+        rank_networks();
+        try_to_connect();
+    }
     else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED)
     {
         wifi_event_sta_disconnected_t* event = (wifi_event_sta_disconnected_t*)event_data;
@@ -161,9 +229,29 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
                  event->reason, wifi_reason_to_str(event->reason));
         ESP_LOGI(TAG, "Retry state: attempt %d/%d, network %d/%d",
                  s_reconnect_retries, MAX_RECONNECT_RETRIES,
-                 s_current_network_index + 1, s_num_networks);
+                 s_connect_order_pos + 1, s_num_networks);
+        bool was_connected = s_is_connected;
         s_is_connected = false;
 
+        // Intentional disconnect - don't start another round of connection attempts
+        if (s_stop_requested) {
+            ESP_LOGI(TAG, "Disconnect requested - not reconnecting");
+            return;
+        }
+        wifi_tx_power_note_disconnect(was_connected);
+
+        // Association lost while parked between sends. Nobody is waiting on the
+        // connection, so stop the radio instead of cycling networks at full power;
+        // the next send restarts WiFi from scratch.
+        if (s_idle) {
+            ESP_LOGW(TAG, "Idle association lost - stopping WiFi until the next send");
+            s_idle = false;
+            s_stop_requested = true;
+            s_scan_in_progress = false;
+            esp_wifi_stop();
+            return;
+        }
+
         // Add safety checks to prevent crashes during WiFi issues
         if (event->reason == WIFI_REASON_NO_AP_FOUND ||
             event->reason == WIFI_REASON_NO_AP_FOUND_W_COMPATIBLE_SECURITY ||
@@ -173,22 +261,27 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
             vTaskDelay(pdMS_TO_TICKS(5000)); // 5 second delay for AP not found errors
         }
 
-        if (s_reconnect_retries < MAX_RECONNECT_RETRIES)
+        // Networks that were missing from a successful scan get a single attempt only
+        // (they may be hidden SSIDs), instead of burning the full retry budget
+        int max_retries = (!s_scan_valid || s_scan_hints[s_current_network_index].seen) ? MAX_RECONNECT_RETRIES : 0;
+
+        if (s_reconnect_retries < max_retries)
         {
             s_reconnect_retries++;
             ESP_LOGI(TAG, "Retrying connection to '%s' (attempt %d/%d)...",
-                     s_wifi_networks[s_current_network_index].ssid, s_reconnect_retries, MAX_RECONNECT_RETRIES);
+                     s_wifi_networks[s_current_network_index].ssid, s_reconnect_retries, max_retries);
 
             // Add delay before all reconnection attempts to reduce system stress
             vTaskDelay(pdMS_TO_TICKS(2000)); // 2 second delay before retry
             ESP_LOGI(TAG, "Initiating reconnection attempt");
+            s_cycle_attempts++;
             esp_wifi_connect();
         }
         else
         {
             ESP_LOGI(TAG, "Failed to reconnect to '%s'. Trying next network.",
                      s_wifi_networks[s_current_network_index].ssid);
-            s_current_network_index = (s_current_network_index + 1) % s_num_networks;
+            s_connect_order_pos = (s_connect_order_pos + 1) % s_num_networks;
             s_reconnect_retries = 0;
 
             // Add delay before trying next network
@@ -205,6 +298,7 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
         ESP_LOGI(TAG, "Connection successful - resetting retry counters");
         s_reconnect_retries = 0;
         s_is_connected = true;
+        record_connection_success();
     }
 }
 
@@ -238,6 +332,8 @@ static void parse_wifi_credentials()
     }
     free(wifi_credentials_copy);
     ESP_LOGI(TAG, "Found %d WiFi networks in credentials.", s_num_networks);
+
+    load_last_good_network();
 }
 
 static void try_to_connect(void)
@@ -248,6 +344,9 @@ static void try_to_connect(void)
         return;
     }
 
+    s_current_network_index = s_connect_order[s_connect_order_pos];
+    s_network_stats[s_current_network_index].attempts++;
+
     ESP_LOGI(TAG, "Attempting to connect to network: %s (heap: %zu bytes)",
              s_wifi_networks[s_current_network_index].ssid, esp_get_free_heap_size());
 
@@ -260,6 +359,18 @@ static void try_to_connect(void)
     strncpy((char*)wifi_config.sta.ssid, s_wifi_networks[s_current_network_index].ssid, sizeof(wifi_config.sta.ssid));
     strncpy((char*)wifi_config.sta.password, s_wifi_networks[s_current_network_index].password,
             sizeof(wifi_config.sta.password));
+    if (s_power_save) {
+        // Number of beacon intervals between wakeups while in modem sleep
+        wifi_config.sta.listen_interval = s_listen_interval;
+    }
+
+    // Pin channel and BSSID from the scan so the driver doesn't rescan every channel
+    const wifi_scan_hint_t *hint = &s_scan_hints[s_current_network_index];
+    if (s_scan_valid && hint->seen) {
+        wifi_config.sta.channel = hint->channel;
+        memcpy(wifi_config.sta.bssid, hint->bssid, sizeof(wifi_config.sta.bssid));
+        wifi_config.sta.bssid_set = true;
+    }
 
     // Now try to set the config with retry logic
     int retry_count = 0;
@@ -284,9 +395,168 @@ static void try_to_connect(void)
     }
 
     ESP_LOGI(TAG, "WiFi config set - initiating connection");
+    s_cycle_attempts++;
     esp_wifi_connect();
 }
 
+/**
+ * @brief Start a single fast active scan used to rank the configured networks
+ */
+static esp_err_t start_network_scan(void)
+{
+    wifi_scan_config_t scan_config = {
+        .show_hidden = false,
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+        .scan_time.active.min = SCAN_ACTIVE_MIN_MS,
+        .scan_time.active.max = SCAN_ACTIVE_MAX_MS,
+    };
+
+    esp_err_t err = esp_wifi_scan_start(&scan_config, false);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Network scan failed to start: %s - using stored order", esp_err_to_name(err));
+        return err;
+    }
+
+    s_scan_in_progress = true;
+    ESP_LOGI(TAG, "Scanning to rank %d configured networks", s_num_networks);
+    return ESP_OK;
+}
+
+/**
+ * @brief Match scan results against the configured SSIDs, keeping the strongest AP for each
+ */
+static void collect_scan_results(void)
+{
+    memset(s_scan_hints, 0, sizeof(s_scan_hints));
+
+    uint16_t ap_count = MAX_SCAN_RECORDS;
+    wifi_ap_record_t *records = malloc(MAX_SCAN_RECORDS * sizeof(wifi_ap_record_t));
+    if (records == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate memory for scan results");
+        esp_wifi_clear_ap_list();
+        return;
+    }
+
+    esp_err_t err = esp_wifi_scan_get_ap_records(&ap_count, records);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to read scan results: %s", esp_err_to_name(err));
+        free(records);
+        return;
+    }
+
+    for (int i = 0; i < s_num_networks; i++) {
+        s_network_stats[i].last_rssi = 0;
+        for (int r = 0; r < ap_count; r++) {
+            if (strncmp((const char*)records[r].ssid, s_wifi_networks[i].ssid, sizeof(records[r].ssid)) != 0) {
+                continue;
+            }
+            if (!s_scan_hints[i].seen || records[r].rssi > s_scan_hints[i].rssi) {
+                s_scan_hints[i].seen = true;
+                s_scan_hints[i].rssi = records[r].rssi;
+                s_scan_hints[i].channel = records[r].primary;
+                memcpy(s_scan_hints[i].bssid, records[r].bssid, sizeof(s_scan_hints[i].bssid));
+                s_network_stats[i].last_rssi = records[r].rssi;
+            }
+        }
+    }
+
+    free(records);
+    s_scan_valid = true;
+    ESP_LOGI(TAG, "Scan complete: %d APs visible", ap_count);
+}
+
+/**
+ * @brief Order the configured networks for this cycle
+ *
+ * Visible networks are ranked by RSSI, with a bonus for the last network that
+ * worked. Networks missing from the scan go last, last-known-good first.
+ * Without a scan, the last-known-good network simply moves to the front.
+ */
+static void rank_networks(void)
+{
+    int scores[MAX_WIFI_NETWORKS];
+
+    for (int i = 0; i < s_num_networks; i++) {
+        bool is_last_good = (i == s_last_good_index);
+        if (s_scan_valid && s_scan_hints[i].seen) {
+            scores[i] = s_scan_hints[i].rssi + (is_last_good ? LAST_GOOD_RSSI_BONUS_DB : 0);
+        } else {
+            scores[i] = (is_last_good ? -1000 : -1001);
+        }
+
+        // Insertion sort keeps configuration order for equal scores
+        int pos = i;
+        while (pos > 0 && scores[s_connect_order[pos - 1]] < scores[i]) {
+            s_connect_order[pos] = s_connect_order[pos - 1];
+            pos--;
+        }
+        s_connect_order[pos] = i;
+    }
+    s_connect_order_pos = 0;
+
+    for (int pos = 0; pos < s_num_networks; pos++) {
+        int i = s_connect_order[pos];
+        if (s_scan_valid && s_scan_hints[i].seen) {
+            ESP_LOGI(TAG, "Rank %d: '%s' %ddBm ch%d%s", pos + 1, s_wifi_networks[i].ssid,
+                     s_scan_hints[i].rssi, s_scan_hints[i].channel, i == s_last_good_index ? " (last good)" : "");
+        } else {
+            ESP_LOGI(TAG, "Rank %d: '%s' %s%s", pos + 1, s_wifi_networks[i].ssid,
+                     s_scan_valid ? "not seen" : "no scan", i == s_last_good_index ? " (last good)" : "");
+        }
+    }
+}
+
+/**
+ * @brief Load the last-known-good network index from NVS (survives power loss)
+ */
+static void load_last_good_network(void)
+{
+    if (s_last_good_index >= 0) {
+        return; // Already known from RTC memory after deep sleep
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+    int8_t index = -1;
+    if (nvs_get_i8(handle, KEY_LAST_GOOD, &index) == ESP_OK && index >= 0 && index < s_num_networks) {
+        s_last_good_index = index;
+        ESP_LOGI(TAG, "Last-known-good network: '%s'", s_wifi_networks[index].ssid);
+    }
+    nvs_close(handle);
+}
+
+/**
+ * @brief Update statistics and last-known-good memory after getting an IP
+ */
+static void record_connection_success(void)
+{
+    wifi_network_stats_t *stats = &s_network_stats[s_current_network_index];
+    stats->successes++;
+    if (s_cycle_attempts == 1) {
+        stats->first_try++;
+    }
+
+    ESP_LOGI(TAG, "'%s' stats: %u/%u sequences succeeded, %u on first attempt (this cycle: %d attempts)",
+             s_wifi_networks[s_current_network_index].ssid, stats->successes, stats->attempts,
+             stats->first_try, s_cycle_attempts);
+
+    if (s_last_good_index == s_current_network_index) {
+        return;
+    }
+    s_last_good_index = (int8_t)s_current_network_index;
+
+    // Only write flash when the preferred network actually changes
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        if (nvs_set_i8(handle, KEY_LAST_GOOD, s_last_good_index) == ESP_OK) {
+            nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+}
+
 void wifi_manager_init(void)
 {
     ESP_LOGI(TAG, "WiFi manager initialization starting");
@@ -321,10 +591,38 @@ void wifi_manager_init(void)
     }
 
     // These functions are safe to call multiple times to start/restart the WiFi connection.
+    // Each call is one connect request, so the first-try statistic counts from here.
+    s_stop_requested = false;
+    s_idle = false;
+    s_cycle_attempts = 0;
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+    wifi_tx_power_apply_protocol();
     ESP_ERROR_CHECK(esp_wifi_start());
-    ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_NONE));
-    ESP_LOGI(TAG, "WiFi stack started in station mode");
+    wifi_tx_power_apply_power();
+    ESP_ERROR_CHECK(esp_wifi_set_ps(s_power_save ? WIFI_PS_MAX_MODEM : WIFI_PS_NONE));
+    ESP_LOGI(TAG, "WiFi stack started in station mode (power save: %s)",
+             s_power_save ? "max modem" : "none");
+}
+
+void wifi_manager_set_power_save(bool enabled, uint16_t listen_interval)
+{
+    s_power_save = enabled;
+    s_listen_interval = listen_interval;
+}
+
+void wifi_manager_set_idle(bool idle)
+{
+    s_idle = idle && s_is_connected;
+}
+
+void wifi_manager_stop(void)
+{
+    s_stop_requested = true;
+    s_idle = false;
+    s_scan_in_progress = false;
+    esp_wifi_disconnect();
+    esp_wifi_stop();
+    s_is_connected = false;
 }
 
 bool wifi_is_connected(void)
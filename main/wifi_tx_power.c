@@ -0,0 +1,195 @@
+/**
+* @file wifi_tx_power.c
+ *
+ * Adaptive WiFi transmit power and PHY mode selection from measured RSSI.
+ *
+ * The downlink RSSI is averaged across cycles. When it sits well above what a
+ * reliable link needs, the maximum TX power is stepped down 2 dB per cycle;
+ * any failed connect or dropped link raises it straight back up and holds it
+ * there for a while. Very weak links additionally enable Espressif long range
+ * (LR) mode alongside 802.11b/g/n. Outcomes are counted per power level so the
+ * logs show whether a lower level costs retries.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include "wifi_tx_power.h"
+#include "app_config.h"
+#include "wifi_manager.h"
+#include "esp_wifi.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+
+#define TAG "TX_POWER"
+
+#define TX_POWER_MIN_DBM 8              // Keep some headroom for the AP's noise floor
+#define TX_POWER_MAX_DBM 20             // ESP32-C3 maximum
+#define TX_POWER_STEP_DB 2
+#define TX_POWER_RAISE_DB 4             // Recovery step after a failure
+#define TX_POWER_HOLD_CYCLES 6          // Cycles to wait after a raise before stepping down again
+#define TX_LEVEL_COUNT (((TX_POWER_MAX_DBM - TX_POWER_MIN_DBM) / TX_POWER_STEP_DB) + 1)
+#define TARGET_RSSI_DBM (-67)           // Comfortable signal for stable MCS rates
+#define MARGIN_RESERVE_DB 6             // Margin left in place for fading
+#define RSSI_EWMA_DIVISOR 4             // Weight 1/4 for each new sample
+#define LR_ENABLE_RSSI_DBM (-82)
+#define LR_DISABLE_RSSI_DBM (-75)
+#define RETRIES_BEFORE_RAISE 2          // Connect retries in one cycle that count as a bad link
+
+/**
+ * @brief Outcome counters for one TX power level
+ */
+typedef struct {
+    uint16_t cycles;
+    uint16_t failures;                  // Cycles that did not connect
+    uint16_t retries;                   // Failed connect attempts inside a cycle
+    uint16_t link_losses;               // Established links that dropped
+} tx_level_stats_t;
+
+/**
+ * @brief Controller state, kept in RTC memory so it survives night deep sleep
+ */
+typedef struct {
+    bool initialized;
+    bool long_range;
+    int8_t power_dbm;
+    uint8_t hold_cycles;
+    int16_t rssi_ewma_x16;              // Average RSSI in 1/16 dBm
+    tx_level_stats_t level_stats[TX_LEVEL_COUNT];
+} tx_power_state_t;
+
+static RTC_DATA_ATTR tx_power_state_t s_state = { .power_dbm = TX_POWER_MAX_DBM };
+
+// Events seen since the last update, reset every cycle
+static uint16_t s_cycle_retries = 0;
+static bool s_cycle_link_lost = false;
+
+static tx_level_stats_t* current_level_stats(void) {
+    return &s_state.level_stats[(s_state.power_dbm - TX_POWER_MIN_DBM) / TX_POWER_STEP_DB];
+}
+
+void wifi_tx_power_apply_protocol(void) {
+#if CONFIG_WIFI_ADAPTIVE_TX_POWER
+    uint8_t protocol = WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N;
+    if (s_state.long_range) {
+        protocol |= WIFI_PROTOCOL_LR;
+    }
+    esp_err_t err = esp_wifi_set_protocol(WIFI_IF_STA, protocol);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to set PHY protocol: %s", esp_err_to_name(err));
+    }
+#endif
+}
+
+void wifi_tx_power_apply_power(void) {
+#if CONFIG_WIFI_ADAPTIVE_TX_POWER
+    // Driver units are 0.25 dBm
+    esp_err_t err = esp_wifi_set_max_tx_power(s_state.power_dbm * 4);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to set TX power to %d dBm: %s", s_state.power_dbm, esp_err_to_name(err));
+    }
+#endif
+}
+
+void wifi_tx_power_note_disconnect(bool was_connected) {
+    if (was_connected) {
+        s_cycle_link_lost = true;
+    } else if (s_cycle_retries < UINT16_MAX) {
+        s_cycle_retries++;
+    }
+}
+
+/**
+ * @brief Pick the power level for the next cycle from the averaged RSSI
+ */
+static int8_t choose_power(bool degraded) {
+    int8_t power = s_state.power_dbm;
+
+    if (degraded) {
+        power += TX_POWER_RAISE_DB;
+        s_state.hold_cycles = TX_POWER_HOLD_CYCLES;
+    } else if (s_state.hold_cycles > 0) {
+        s_state.hold_cycles--;
+    } else {
+        // Assume a roughly symmetric link: every dB of downlink margin above the
+        // reserve is a dB the uplink can give up
+        int rssi = s_state.rssi_ewma_x16 / 16;
+        int spare_db = rssi - TARGET_RSSI_DBM - MARGIN_RESERVE_DB;
+        int desired = TX_POWER_MAX_DBM - (spare_db > 0 ? spare_db : 0);
+
+        if (desired < power) {
+            power -= TX_POWER_STEP_DB;      // Step down slowly
+        } else if (desired > power) {
+            power = desired;                // Raise at once
+        }
+    }
+
+    if (power > TX_POWER_MAX_DBM) {
+        power = TX_POWER_MAX_DBM;
+    }
+    if (power < TX_POWER_MIN_DBM) {
+        power = TX_POWER_MIN_DBM;
+    }
+    // Keep to the step grid so the per-level counters line up
+    return TX_POWER_MIN_DBM + ((power - TX_POWER_MIN_DBM) / TX_POWER_STEP_DB) * TX_POWER_STEP_DB;
+}
+
+void wifi_tx_power_update(bool connected) {
+#if CONFIG_WIFI_ADAPTIVE_TX_POWER
+    tx_level_stats_t *stats = current_level_stats();
+    stats->cycles++;
+    stats->retries += s_cycle_retries;
+    if (!connected) {
+        stats->failures++;
+    }
+    if (s_cycle_link_lost) {
+        stats->link_losses++;
+    }
+
+    int8_t rssi = 0;
+    if (connected && wifi_get_rssi(&rssi) == ESP_OK) {
+        if (!s_state.initialized) {
+            s_state.rssi_ewma_x16 = rssi * 16;
+            s_state.initialized = true;
+        } else {
+            // Signed division: a right shift of the usually negative step would round toward -inf
+            s_state.rssi_ewma_x16 += (rssi * 16 - s_state.rssi_ewma_x16) / RSSI_EWMA_DIVISOR;
+        }
+    }
+
+    bool degraded = !connected || s_cycle_link_lost || s_cycle_retries >= RETRIES_BEFORE_RAISE;
+    int8_t previous_power = s_state.power_dbm;
+    if (s_state.initialized) {
+        s_state.power_dbm = choose_power(degraded);
+
+        int avg_rssi = s_state.rssi_ewma_x16 / 16;
+        bool previous_lr = s_state.long_range;
+        if (avg_rssi <= LR_ENABLE_RSSI_DBM && s_state.power_dbm == TX_POWER_MAX_DBM) {
+            s_state.long_range = true;
+        } else if (avg_rssi >= LR_DISABLE_RSSI_DBM) {
+            s_state.long_range = false;
+        }
+        if (s_state.long_range != previous_lr) {
+            ESP_LOGI(TAG, "802.11 LR mode %s from next connection",
+                     s_state.long_range ? "enabled" : "disabled");
+        }
+    }
+
+    if (s_state.power_dbm != previous_power && connected) {
+        wifi_tx_power_apply_power();
+    }
+
+    tx_level_stats_t *level = current_level_stats();
+    ESP_LOGI(TAG, "TX power %d -> %d dBm (rssi %d, avg %d dBm, retries %u%s) | at %d dBm: "
+             "%u cycles, %u failed, %u retries, %u drops",
+             previous_power, s_state.power_dbm, rssi, s_state.rssi_ewma_x16 / 16,
+             s_cycle_retries, s_cycle_link_lost ? ", link lost" : "",
+             s_state.power_dbm, level->cycles, level->failures, level->retries, level->link_losses);
+#endif
+
+    s_cycle_retries = 0;
+    s_cycle_link_lost = false;
+}
@@ -0,0 +1,627 @@
+/**
+* @file trace_partly_cloudy.h
+ *
+ * Light level trace for host-side replay tests: two hours around midday at
+ * one reading per second, in lux.
+ *
+ * The first half hour is clear sky, the next hour has broken cumulus whose
+ * shadows take 20-220 s to pass, and overcast moves in for the last half
+ * hour. The trace is synthetic: a smooth clear-sky curve times a cloud
+ * shade factor that eases toward random targets, with 0.4% sensor noise,
+ * from a fixed seed so every run sees the same data.
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define TRACE_PARTLY_CLOUDY_SECONDS 7200
+
+static const uint16_t trace_partly_cloudy[TRACE_PARTLY_CLOUDY_SECONDS] = {
+    52032, 51962, 52042, 51926, 52014, 52011, 52037, 51991, 51970, 51997, 52094, 51961,
+    51989, 52064, 52097, 52141, 52104, 52037, 52055, 52076, 52000, 52097, 52103, 52160,
+    52027, 52054, 52111, 52121, 52005, 51975, 52137, 51986, 52104, 52033, 52101, 52095,
+    52073, 52031, 52130, 52147, 52064, 52206, 52180, 52090, 52158, 52040, 52143, 52133,
+    52167, 52213, 52109, 52203, 52161, 52038, 52115, 52063, 52159, 52122, 52079, 52218,
+    52068, 52073, 52099, 52248, 52178, 52168, 52147, 52092, 52168, 52141, 52158, 52107,
+    52281, 52252, 52180, 52210, 52099, 52298, 52133, 52175, 52261, 52258, 52284, 52151,
+    52261, 52129, 52328, 52130, 52159, 52336, 52272, 52142, 52187, 52273, 52175, 52334,
+    52238, 52330, 52256, 52189, 52320, 52161, 52329, 52226, 52195, 52216, 52267, 52226,
+    52333, 52330, 52242, 52230, 52329, 52317, 52378, 52241, 52227, 52318, 52411, 52297,
+    52289, 52225, 52274, 52369, 52266, 52296, 52314, 52307, 52395, 52424, 52367, 52338,
+    52360, 52374, 52403, 52437, 52336, 52327, 52267, 52351, 52357, 52300, 52404, 52462,
+    52437, 52474, 52470, 52475, 52421, 52389, 52420, 52494, 52305, 52301, 52365, 52429,
+    52440, 52331, 52434, 52434, 52464, 52506, 52492, 52380, 52346, 52482, 52523, 52456,
+    52525, 52340, 52496, 52474, 52522, 52418, 52519, 52404, 52358, 52545, 52503, 52533,
+    52389, 52380, 52377, 52431, 52509, 52395, 52477, 52575, 52440, 52400, 52418, 52556,
+    52592, 52573, 52502, 52464, 52568, 52442, 52591, 52619, 52496, 52576, 52506, 52588,
+    52571, 52522, 52453, 52627, 52618, 52499, 52490, 52613, 52535, 52585, 52484, 52654,
+    52487, 52485, 52618, 52533, 52650, 52574, 52537, 52509, 52633, 52561, 52553, 52627,
+    52494, 52675, 52686, 52629, 52528, 52669, 52548, 52568, 52689, 52703, 52672, 52647,
+    52607, 52663, 52728, 52591, 52652, 52714, 52697, 52651, 52581, 52700, 52655, 52754,
+    52633, 52758, 52609, 52750, 52567, 52771, 52663, 52584, 52664, 52600, 52644, 52601,
+    52604, 52616, 52737, 52602, 52655, 52680, 52767, 52604, 52681, 52675, 52745, 52652,
+    52765, 52734, 52731, 52744, 52626, 52690, 52739, 52738, 52810, 52693, 52840, 52680,
+    52706, 52810, 52710, 52781, 52796, 52731, 52688, 52855, 52832, 52772, 52838, 52766,
+    52693, 52849, 52716, 52842, 52692, 52746, 52771, 52870, 52705, 52867, 52899, 52828,
+    52793, 52889, 52883, 52927, 52783, 52798, 52771, 52745, 52858, 52859, 52858, 52919,
+    52838, 52788, 52799, 52860, 52814, 52802, 52900, 52811, 52835, 52808, 52887, 52857,
+    52823, 52817, 52901, 52785, 52959, 52961, 52848, 52791, 52957, 52825, 52959, 52805,
+    52803, 52905, 52963, 52964, 52955, 52829, 52918, 53009, 52967, 52958, 52925, 52924,
+    52909, 52947, 53044, 53012, 52922, 53047, 52982, 52980, 52966, 52981, 52877, 52879,
+    52975, 52909, 53037, 52938, 52905, 53026, 52915, 53012, 52934, 52893, 52890, 52926,
+    53055, 52995, 52989, 52949, 52961, 53052, 52979, 52924, 52967, 52964, 53042, 53107,
+    53024, 53044, 53091, 53114, 53135, 53058, 53151, 53102, 53067, 53074, 53046, 53144,
+    52975, 53113, 52982, 53019, 53045, 53111, 53050, 53060, 53129, 53149, 53027, 53162,
+    53037, 53139, 53055, 53156, 53178, 53184, 53160, 53144, 53022, 53170, 53061, 53155,
+    53046, 53021, 53186, 53077, 53148, 53230, 53058, 53063, 53207, 53070, 53251, 53243,
+    53237, 53104, 53060, 53152, 53062, 53233, 53276, 53107, 53224, 53121, 53212, 53272,
+    53219, 53245, 53104, 53272, 53240, 53208, 53128, 53204, 53177, 53210, 53157, 53162,
+    53147, 53198, 53221, 53194, 53128, 53249, 53252, 53139, 53208, 53316, 53142, 53195,
+    53291, 53344, 53202, 53195, 53356, 53160, 53265, 53343, 53320, 53362, 53287, 53316,
+    53172, 53198, 53285, 53356, 53285, 53265, 53309, 53393, 53228, 53268, 53228, 53393,
+    53244, 53301, 53221, 53324, 53311, 53385, 53270, 53386, 53315, 53305, 53408, 53297,
+    53286, 53252, 53419, 53431, 53410, 53261, 53347, 53410, 53395, 53440, 53277, 53275,
+    53465, 53406, 53325, 53479, 53362, 53352, 53374, 53291, 53335, 53458, 53472, 53453,
+    53497, 53421, 53387, 53492, 53399, 53520, 53506, 53385, 53315, 53439, 53423, 53380,
+    53331, 53466, 53419, 53365, 53442, 53429, 53456, 53468, 53510, 53367, 53386, 53439,
+    53540, 53411, 53496, 53370, 53520, 53465, 53538, 53491, 53520, 53581, 53401, 53484,
+    53507, 53478, 53392, 53529, 53551, 53598, 53415, 53454, 53482, 53583, 53499, 53516,
+    53505, 53558, 53500, 53584, 53557, 53460, 53532, 53610, 53558, 53450, 53612, 53463,
+    53620, 53648, 53664, 53505, 53583, 53644, 53615, 53541, 53517, 53676, 53680, 53687,
+    53479, 53650, 53503, 53697, 53530, 53589, 53658, 53661, 53583, 53630, 53696, 53692,
+    53652, 53511, 53664, 53570, 53661, 53521, 53704, 53611, 53579, 53629, 53743, 53660,
+    53695, 53645, 53655, 53622, 53647, 53697, 53557, 53704, 53676, 53565, 53761, 53718,
+    53701, 53610, 53608, 53694, 53695, 53703, 53653, 53640, 53758, 53717, 53757, 53643,
+    53685, 53724, 53723, 53633, 53687, 53614, 53740, 53797, 53670, 53670, 53758, 53679,
+    53817, 53705, 53784, 53738, 53666, 53786, 53801, 53762, 53701, 53717, 53783, 53825,
+    53666, 53672, 53805, 53697, 53747, 53780, 53858, 53823, 53702, 53778, 53799, 53772,
+    53713, 53750, 53696, 53854, 53772, 53851, 53912, 53870, 53856, 53802, 53910, 53833,
+    53853, 53733, 53843, 53853, 53796, 53918, 53830, 53939, 53770, 53907, 53910, 53914,
+    53838, 53775, 53875, 53775, 53802, 53874, 53814, 53832, 53774, 53908, 53938, 53871,
+    53857, 53936, 53857, 53921, 53936, 53819, 53987, 53920, 53800, 53945, 53861, 54008,
+    53949, 53944, 53897, 54016, 53870, 53966, 53904, 53902, 53942, 53930, 54003, 53912,
+    53882, 54040, 54049, 54043, 53894, 53897, 54009, 53989, 54013, 53936, 53944, 53976,
+    53927, 53953, 53924, 54032, 53952, 53935, 54011, 54021, 54035, 53900, 53996, 53924,
+    54069, 54097, 53908, 53911, 54103, 53983, 54081, 54099, 54074, 53918, 54103, 53981,
+    54013, 54112, 53954, 54018, 54135, 54124, 54062, 53961, 54044, 54127, 54136, 54084,
+    54128, 54122, 53981, 54113, 54057, 54042, 53994, 54065, 54053, 54167, 54008, 54188,
+    54059, 54042, 54024, 54088, 54099, 54059, 54188, 54078, 54200, 54027, 54111, 54086,
+    54138, 54175, 54063, 54225, 54197, 54203, 54035, 54095, 54166, 54110, 54077, 54064,
+    54146, 54135, 54048, 54078, 54179, 54088, 54257, 54106, 54108, 54153, 54250, 54164,
+    54129, 54199, 54268, 54110, 54216, 54132, 54243, 54207, 54171, 54241, 54199, 54247,
+    54208, 54198, 54184, 54184, 54141, 54199, 54135, 54297, 54129, 54318, 54176, 54133,
+    54177, 54254, 54240, 54330, 54245, 54303, 54172, 54281, 54357, 54338, 54270, 54282,
+    54169, 54208, 54186, 54278, 54191, 54306, 54256, 54364, 54244, 54282, 54360, 54356,
+    54365, 54304, 54394, 54362, 54397, 54233, 54251, 54288, 54227, 54239, 54376, 54219,
+    54376, 54419, 54360, 54277, 54348, 54305, 54308, 54357, 54297, 54412, 54285, 54299,
+    54390, 54401, 54418, 54255, 54385, 54353, 54411, 54283, 54303, 54387, 54406, 54454,
+    54381, 54327, 54438, 54485, 54315, 54315, 54398, 54425, 54320, 54362, 54375, 54309,
+    54336, 54411, 54459, 54526, 54313, 54400, 54526, 54371, 54328, 54388, 54402, 54462,
+    54405, 54460, 54475, 54391, 54527, 54457, 54558, 54541, 54514, 54557, 54544, 54551,
+    54446, 54367, 54442, 54509, 54459, 54372, 54502, 54421, 54576, 54582, 54550, 54536,
+    54498, 54423, 54535, 54480, 54456, 54611, 54543, 54434, 54423, 54594, 54552, 54556,
+    54539, 54571, 54551, 54587, 54485, 54597, 54449, 54630, 54648, 54545, 54606, 54460,
+    54651, 54626, 54451, 54537, 54473, 54569, 54592, 54566, 54605, 54670, 54664, 54497,
+    54593, 54591, 54489, 54482, 54690, 54683, 54495, 54536, 54518, 54615, 54704, 54547,
+    54549, 54715, 54542, 54536, 54530, 54613, 54523, 54695, 54667, 54584, 54657, 54687,
+    54543, 54612, 54561, 54567, 54736, 54613, 54689, 54610, 54578, 54767, 54725, 54694,
+    54714, 54593, 54670, 54629, 54662, 54742, 54651, 54590, 54655, 54679, 54637, 54618,
+    54596, 54598, 54660, 54753, 54622, 54739, 54761, 54784, 54666, 54778, 54617, 54704,
+    54687, 54757, 54676, 54678, 54705, 54757, 54832, 54713, 54786, 54786, 54645, 54800,
+    54754, 54716, 54862, 54656, 54663, 54854, 54839, 54674, 54714, 54794, 54799, 54820,
+    54765, 54864, 54695, 54841, 54745, 54744, 54887, 54698, 54818, 54888, 54768, 54877,
+    54856, 54877, 54788, 54831, 54890, 54786, 54717, 54896, 54814, 54784, 54900, 54902,
+    54781, 54886, 54890, 54825, 54776, 54888, 54903, 54857, 54816, 54892, 54905, 54757,
+    54919, 54894, 54807, 54917, 54966, 54949, 54965, 54830, 54929, 54838, 54981, 54898,
+    54921, 54932, 54825, 54866, 54883, 54806, 54950, 54816, 54909, 55015, 54826, 54854,
+    54909, 54833, 54902, 54818, 54847, 54910, 55036, 54973, 54913, 54999, 54873, 54850,
+    54877, 55042, 54903, 54921, 55063, 55055, 54884, 54973, 54904, 55063, 54978, 54983,
+    55025, 54908, 54942, 54980, 55079, 54984, 54981, 55087, 55043, 55069, 54911, 55089,
+    55056, 54947, 55027, 54933, 54908, 55100, 55110, 55071, 55086, 54984, 54951, 54976,
+    54980, 55115, 55033, 55109, 54996, 54956, 55043, 54962, 55103, 55044, 54995, 55086,
+    55012, 55129, 55103, 55072, 55131, 54984, 55010, 55171, 55116, 54968, 55112, 55065,
+    55108, 55066, 55068, 55054, 55159, 55196, 55116, 55148, 55080, 55089, 55054, 55135,
+    55044, 55205, 55184, 55063, 55220, 55218, 55191, 55044, 55219, 55068, 55235, 55122,
+    55142, 55116, 55248, 55218, 55049, 55097, 55162, 55240, 55076, 55253, 55143, 55141,
+    55234, 55150, 55259, 55250, 55125, 55098, 55195, 55088, 55244, 55243, 55198, 55208,
+    55280, 55258, 55138, 55194, 55243, 55236, 55278, 55213, 55290, 55170, 55195, 55155,
+    55228, 55175, 55122, 55210, 55278, 55185, 55255, 55231, 55138, 55143, 55319, 55198,
+    55337, 55314, 55231, 55224, 55266, 55320, 55179, 55202, 55208, 55264, 55291, 55209,
+    55196, 55346, 55206, 55203, 55366, 55339, 55270, 55344, 55275, 55202, 55235, 55273,
+    55318, 55316, 55291, 55212, 55272, 55407, 55307, 55233, 55298, 55291, 55344, 55347,
+    55346, 55407, 55297, 55394, 55391, 55385, 55408, 55418, 55325, 55267, 55290, 55274,
+    55403, 55425, 55416, 55254, 55385, 55338, 55378, 55390, 55262, 55267, 55323, 55410,
+    55282, 55449, 55313, 55480, 55273, 55296, 55460, 55477, 55416, 55408, 55356, 55354,
+    55353, 55372, 55434, 55478, 55340, 55472, 55438, 55491, 55456, 55498, 55321, 55456,
+    55443, 55457, 55504, 55402, 55419, 55366, 55390, 55480, 55389, 55379, 55502, 55503,
+    55548, 55424, 55468, 55405, 55534, 55391, 55459, 55418, 55524, 55471, 55501, 55484,
+    55531, 55484, 55410, 55581, 55379, 55453, 55522, 55403, 55462, 55595, 55419, 55476,
+    55453, 55552, 55495, 55512, 55504, 55464, 55451, 55410, 55543, 55595, 55448, 55580,
+    55450, 55579, 55560, 55585, 55467, 55533, 55484, 55521, 55650, 55652, 55485, 55595,
+    55487, 55458, 55638, 55653, 55591, 55501, 55672, 55664, 55493, 55589, 55607, 55590,
+    55668, 55689, 55478, 55639, 55587, 55557, 55665, 55557, 55487, 55693, 55692, 55512,
+    55655, 55677, 55668, 55672, 55583, 55596, 55577, 55689, 55678, 55730, 55695, 55646,
+    55664, 55529, 55557, 55674, 55689, 55731, 55661, 55567, 55609, 55755, 55756, 55620,
+    55584, 55551, 55684, 55549, 55657, 55611, 55741, 55627, 55693, 55629, 55636, 55786,
+    55568, 55762, 55674, 55677, 55644, 55643, 55683, 55703, 55648, 55749, 55776, 55764,
+    55767, 55616, 55779, 55737, 55634, 55741, 55646, 55777, 55683, 55643, 55700, 55764,
+    55660, 55815, 55670, 55797, 55650, 55828, 55827, 55707, 55755, 55644, 55841, 55702,
+    55765, 55734, 55782, 55694, 55864, 55722, 55773, 55853, 55696, 55821, 55824, 55717,
+    55734, 55668, 55695, 55746, 55831, 55727, 55876, 55733, 55771, 55836, 55741, 55768,
+    55841, 55875, 55753, 55718, 55758, 55786, 55775, 55789, 55778, 55921, 55914, 55928,
+    55876, 55839, 55738, 55739, 55912, 55857, 55849, 55786, 55812, 55937, 55861, 55940,
+    55771, 55743, 55894, 55875, 55955, 55810, 55848, 55838, 55932, 55861, 55784, 55872,
+    55767, 55779, 55918, 55841, 55881, 55946, 55966, 55814, 55823, 55980, 55936, 55995,
+    55981, 55954, 55871, 55994, 55904, 55997, 55956, 55980, 55940, 55906, 55845, 55929,
+    55859, 56033, 55959, 55963, 55832, 55929, 56031, 55990, 55884, 56044, 55895, 55870,
+    55852, 56047, 56013, 55871, 55979, 55965, 56042, 55961, 55933, 55943, 55874, 55935,
+    55951, 55900, 55867, 56040, 55899, 56031, 56011, 56075, 55937, 56068, 55898, 55979,
+    55920, 56047, 55902, 55889, 55895, 56045, 56081, 55990, 55933, 56065, 56095, 55940,
+    56082, 55996, 56027, 55972, 56046, 55928, 56029, 56093, 56032, 56086, 56006, 55953,
+    56126, 55983, 55968, 56040, 56101, 56087, 56011, 56053, 56146, 56007, 56109, 56046,
+    56168, 56076, 56029, 55973, 56165, 56112, 55993, 56080, 55998, 55988, 56165, 56022,
+    56169, 56062, 56024, 56047, 56132, 56035, 56190, 56102, 56001, 56123, 56151, 56214,
+    56176, 56198, 56052, 56007, 56036, 56099, 56212, 56040, 56083, 56147, 56043, 56145,
+    56162, 56125, 56127, 56118, 56178, 56244, 56136, 56212, 56175, 56098, 56186, 56043,
+    56146, 56059, 56088, 56081, 56268, 56189, 56065, 56084, 56116, 56223, 56074, 56217,
+    56256, 56213, 56183, 56113, 56272, 56202, 56282, 56262, 56231, 56092, 56207, 56096,
+    56308, 56103, 56143, 56296, 56178, 56289, 56131, 56321, 56325, 56186, 56121, 56261,
+    56123, 56192, 56301, 56251, 56236, 56143, 56207, 56267, 56147, 56289, 56182, 56275,
+    53204, 50250, 47688, 45295, 43143, 41041, 39114, 37378, 35827, 34437, 33064, 31795,
+    30701, 29585, 28708, 27819, 26982, 26176, 25548, 24840, 24300, 23719, 23275, 22827,
+    22362, 22010, 21617, 21338, 21046, 20758, 20463, 20308, 20018, 19870, 19692, 19508,
+    19326, 19193, 19073, 18993, 18868, 18773, 18656, 18592, 18513, 18450, 18380, 18294,
+    18271, 18187, 18174, 18090, 18060, 17999, 17959, 17980, 17940, 17897, 17914, 17853,
+    17819, 17843, 17782, 17788, 17771, 17754, 17774, 17722, 17705, 17749, 17711, 17682,
+    17716, 17695, 17659, 17660, 17674, 17676, 17641, 17694, 17637, 17636, 17681, 17665,
+    17668, 17635, 17609, 17639, 17630, 17657, 17612, 17638, 17606, 17630, 17656, 17609,
+    17606, 17616, 17650, 17655, 17619, 17658, 17653, 17615, 17611, 17619, 17663, 17609,
+    17599, 17640, 17652, 17644, 17605, 17619, 17650, 17617, 17637, 17625, 17625, 17642,
+    17629, 17652, 17606, 17645, 17632, 17628, 17655, 17627, 17636, 17643, 17623, 17618,
+    17637, 17613, 17664, 17653, 17644, 17622, 17660, 17658, 17662, 17662, 17658, 17623,
+    17621, 17651, 17627, 17617, 17652, 17658, 17642, 17662, 17617, 17669, 17636, 17651,
+    17629, 17652, 17641, 17627, 17634, 17688, 17640, 17661, 17644, 17664, 17670, 17677,
+    17671, 17690, 17666, 17641, 17696, 17687, 17663, 17694, 17642, 17662, 17652, 17662,
+    17666, 17677, 17636, 17694, 17692, 17688, 17660, 17644, 17638, 17678, 17673, 17652,
+    17670, 17685, 17696, 17670, 17679, 17662, 17649, 17686, 17710, 17690, 17690, 17670,
+    17714, 17699, 17684, 17653, 17688, 17715, 17656, 17652, 17716, 20835, 23637, 26340,
+    28699, 30911, 33064, 34938, 36660, 38315, 39672, 41107, 42300, 43380, 44526, 45515,
+    46336, 47212, 47894, 48583, 49230, 49846, 50352, 50991, 51363, 51860, 52212, 52655,
+    52890, 53266, 53511, 53686, 54028, 54116, 54347, 54555, 54642, 54842, 54963, 55214,
+    55247, 55474, 55470, 55660, 55640, 55686, 55905, 55999, 55935, 56120, 56161, 56054,
+    56182, 56296, 56261, 56262, 56316, 56368, 56480, 56367, 56544, 56518, 56455, 56571,
+    56589, 56556, 56594, 56517, 56609, 56664, 56659, 56564, 56612, 56712, 56645, 56701,
+    56751, 56646, 56615, 56659, 56656, 56727, 56784, 56656, 56649, 56745, 56775, 56665,
+    56751, 56819, 56697, 56798, 56754, 56643, 56690, 56727, 56675, 56715, 56699, 56708,
+    56795, 56795, 56748, 56773, 56814, 56732, 56737, 56892, 56733, 56719, 56726, 56711,
+    56725, 56895, 56737, 56750, 56787, 56760, 56792, 56723, 56846, 56817, 56913, 56727,
+    56743, 56772, 56894, 56726, 56771, 56806, 56918, 56908, 56828, 56920, 56806, 56829,
+    56904, 56780, 56777, 56838, 56737, 56753, 56821, 56742, 56903, 56862, 56891, 56789,
+    56903, 56865, 56828, 56854, 56824, 56915, 56866, 56838, 56785, 56768, 56946, 56906,
+    56870, 56858, 56822, 56941, 56990, 56952, 56779, 56783, 56883, 56825, 56856, 56866,
+    56820, 56934, 56898, 56950, 56955, 56965, 56917, 56891, 56799, 56800, 56899, 56912,
+    56857, 56871, 56904, 56997, 56838, 57017, 56835, 56959, 56818, 56908, 56936, 56826,
+    56888, 56965, 57031, 57024, 56905, 56902, 56935, 56868, 56870, 56965, 56960, 57002,
+    57056, 56960, 56847, 56995, 57040, 56982, 57049, 56925, 56859, 57013, 57070, 56905,
+    56953, 57002, 57041, 56989, 56899, 56891, 57028, 56882, 56913, 57043, 57060, 56991,
+    56880, 56952, 56911, 57040, 56876, 57023, 57059, 56983, 56916, 56962, 57099, 56888,
+    56929, 56941, 56915, 57110, 56968, 57119, 57113, 57025, 57058, 56912, 56957, 57061,
+    56934, 57103, 57032, 57049, 57104, 57068, 57097, 56997, 56940, 57049, 57070, 56972,
+    56932, 57079, 57067, 56941, 57150, 56994, 57120, 57120, 57018, 57135, 57093, 56963,
+    57083, 57103, 56945, 56984, 56960, 56954, 57165, 56978, 56963, 57066, 57042, 57118,
+    57154, 57167, 56965, 57091, 56984, 55759, 54606, 53649, 52681, 51765, 50833, 50064,
+    49550, 48888, 48185, 47711, 47174, 46711, 46295, 45838, 45546, 45276, 44856, 44658,
+    44419, 44209, 43861, 43734, 43529, 43432, 43201, 43017, 43028, 42784, 42722, 42688,
+    42555, 42450, 42413, 42315, 42294, 42080, 42047, 42120, 41982, 41921, 41891, 41933,
+    41853, 41814, 41776, 41685, 41726, 41721, 41627, 41743, 41662, 41680, 41617, 41541,
+    41598, 41626, 41662, 41509, 41531, 41523, 41619, 41577, 41515, 41546, 41576, 41587,
+    41512, 41449, 41570, 41566, 41560, 41506, 41478, 41528, 41448, 41510, 41571, 41564,
+    41523, 41540, 41486, 41431, 41510, 41476, 41429, 41536, 41437, 41492, 41532, 41526,
+    41563, 41490, 41526, 41566, 41422, 41541, 41469, 41494, 41499, 41468, 41516, 41451,
+    41525, 41464, 41507, 41506, 41562, 41555, 41489, 41529, 41524, 41459, 41458, 41510,
+    41481, 41484, 41456, 41575, 41553, 41531, 41451, 41564, 41581, 41492, 41479, 41585,
+    41539, 41446, 41476, 41576, 41548, 41465, 41446, 41462, 41453, 41569, 41559, 41599,
+    41495, 41488, 41491, 41596, 41533, 41612, 41595, 41532, 41517, 41611, 41563, 41507,
+    41499, 41603, 41484, 41535, 41556, 41523, 41470, 41548, 41569, 41583, 41584, 41524,
+    41573, 41613, 41573, 41509, 41623, 41538, 41477, 41546, 41543, 41598, 41621, 41610,
+    41521, 41559, 41547, 41563, 41582, 41545, 41573, 41565, 41555, 41556, 41534, 41621,
+    41570, 41626, 41555, 41532, 41553, 41548, 41574, 41589, 41568, 41595, 41640, 41632,
+    41634, 41506, 41542, 41624, 41565, 41668, 41601, 41535, 41596, 41593, 41551, 41533,
+    41525, 42905, 44009, 45115, 46108, 46956, 47714, 48544, 49331, 49938, 50445, 51130,
+    51641, 52072, 52375, 52794, 53165, 53477, 53891, 54038, 54462, 54633, 54872, 55065,
+    55250, 55460, 55545, 55762, 55782, 55934, 55992, 56107, 56348, 56344, 56552, 56473,
+    56641, 56558, 56733, 56733, 56794, 56769, 57023, 57023, 57022, 56918, 57102, 57076,
+    57167, 57027, 57117, 57224, 57142, 57201, 57315, 57253, 57330, 57285, 57263, 57378,
+    57423, 57430, 57229, 57277, 57306, 57266, 57258, 57469, 57344, 57465, 57415, 57356,
+    57322, 57488, 57489, 57435, 57345, 57420, 57326, 57466, 57447, 57480, 57481, 57418,
+    57358, 57348, 57435, 57347, 57550, 57401, 57504, 57506, 57497, 57351, 57557, 57377,
+    57560, 57563, 57511, 57447, 57439, 57433, 57554, 57358, 57362, 57460, 57539, 57486,
+    57511, 57552, 57426, 57561, 57457, 57531, 57500, 57557, 57556, 57408, 57500, 57448,
+    57414, 57439, 57525, 57373, 57496, 57587, 57545, 57583, 57398, 57550, 57471, 57399,
+    57525, 57455, 57591, 57607, 57482, 57607, 57433, 57500, 57459, 57391, 57445, 57397,
+    57507, 57466, 57424, 57404, 57564, 57543, 57454, 57512, 57484, 57553, 57600, 57588,
+    57622, 57478, 57504, 57543, 57630, 57467, 57423, 57612, 57464, 57634, 57492, 57644,
+    57562, 57539, 57437, 57641, 57595, 57535, 57424, 57517, 57424, 57597, 57454, 57640,
+    57596, 57650, 57592, 57656, 57485, 57555, 57584, 57457, 57612, 57544, 57470, 57580,
+    57594, 57497, 57512, 57575, 57617, 57452, 57671, 57488, 57648, 57518, 57469, 57523,
+    57464, 57522, 57635, 57579, 57676, 57526, 57686, 57489, 57475, 57494, 57531, 57576,
+    57557, 57476, 57693, 57599, 57509, 57492, 57496, 57607, 57508, 57582, 57557, 57632,
+    57499, 57648, 57639, 57667, 54508, 51707, 49095, 46763, 44552, 42401, 40556, 38836,
+    37342, 35781, 34490, 33305, 32152, 31173, 30142, 29258, 28459, 27740, 27064, 26400,
+    25847, 25281, 24776, 24367, 23892, 23545, 23204, 22905, 22580, 22301, 22046, 21860,
+    21568, 21418, 21271, 21039, 20923, 20747, 20651, 20540, 20378, 20327, 20214, 20126,
+    20078, 19987, 19913, 19854, 19769, 19748, 19691, 19630, 19605, 19625, 19554, 19521,
+    19512, 19480, 19451, 19407, 19393, 19402, 19349, 19379, 19311, 19333, 19291, 19299,
+    19283, 19298, 19268, 19286, 19289, 19266, 19241, 19246, 19241, 19217, 19228, 19204,
+    19219, 19228, 19174, 19178, 19191, 19216, 19196, 19203, 19189, 19161, 19171, 19222,
+    19196, 19204, 19179, 19173, 19223, 19154, 19217, 19207, 22246, 25087, 27742, 30087,
+    32358, 34312, 36191, 37999, 39470, 41046, 42233, 43507, 44600, 45731, 46631, 47563,
+    48274, 49102, 49819, 50476, 50919, 51597, 52081, 52459, 52911, 53219, 53591, 53871,
+    54345, 54584, 54772, 55113, 55226, 55456, 55696, 55826, 55889, 56135, 56308, 56342,
+    56532, 56540, 56687, 56678, 56902, 56965, 56962, 57036, 57111, 57148, 57083, 57282,
+    57283, 57340, 57261, 57466, 57390, 57481, 57457, 57469, 57480, 57517, 57641, 57616,
+    57644, 57693, 57657, 57655, 57673, 57738, 57735, 57556, 57579, 57675, 57554, 57742,
+    57566, 57802, 57669, 57633, 57707, 57804, 57744, 57682, 57733, 57617, 57706, 57813,
+    57677, 57694, 57663, 57665, 57694, 57841, 57839, 57782, 57795, 57799, 57828, 57687,
+    57661, 57827, 57823, 57829, 57748, 57853, 57648, 57661, 57692, 57805, 57858, 57733,
+    57827, 57719, 57831, 57854, 57760, 57688, 57864, 57811, 57820, 57852, 57678, 57780,
+    57775, 57817, 57874, 57750, 57717, 57773, 57889, 57731, 57818, 57702, 57712, 57825,
+    57696, 57860, 57801, 57846, 57878, 57861, 57792, 57899, 57847, 57766, 57899, 57732,
+    57795, 57817, 57811, 57899, 57868, 57689, 57695, 57787, 57866, 57876, 57723, 57909,
+    57889, 57886, 57722, 57841, 57803, 57757, 57760, 57891, 57876, 57810, 57806, 57725,
+    57745, 57850, 57728, 57726, 57706, 57872, 57855, 57704, 57851, 57794, 57899, 57801,
+    57899, 57827, 57924, 57834, 57865, 57905, 57785, 57833, 57785, 57791, 57784, 57871,
+    57811, 57921, 57896, 57864, 57800, 57717, 57856, 57733, 57730, 57920, 57764, 57948,
+    57822, 57896, 57801, 57805, 57855, 57929, 57873, 57938, 57793, 57916, 57855, 57729,
+    57826, 57855, 57860, 57805, 57848, 57789, 57825, 57812, 57732, 57733, 57918, 57827,
+    57952, 57788, 57901, 57748, 57736, 57831, 57870, 57932, 57739, 57892, 57829, 57745,
+    57897, 57915, 57819, 57826, 57945, 57795, 57898, 57882, 57967, 57759, 57858, 57894,
+    57878, 57916, 57818, 57786, 57858, 57967, 57966, 57886, 57940, 57961, 57883, 57784,
+    57835, 57886, 57894, 57760, 57973, 57875, 57794, 57833, 57771, 57989, 57930, 57929,
+    57873, 57964, 57992, 57912, 57981, 57959, 57796, 57963, 57953, 57939, 57961, 57824,
+    57948, 57858, 57824, 57937, 57887, 57909, 57970, 57994, 57799, 57773, 57792, 57998,
+    57937, 57827, 58004, 57820, 57900, 58004, 57812, 57806, 57839, 57960, 57836, 57808,
+    57954, 57952, 57800, 57895, 57974, 57820, 57982, 55213, 52735, 50525, 48507, 46592,
+    44755, 43225, 41615, 40356, 39033, 37867, 36913, 35872, 34919, 34085, 33392, 32658,
+    32004, 31458, 30890, 30416, 29870, 29501, 29100, 28788, 28390, 28062, 27813, 27582,
+    27290, 27139, 26902, 26709, 26504, 26408, 26263, 26135, 26006, 25885, 25799, 25645,
+    25555, 25522, 25468, 25346, 25276, 25246, 25233, 25149, 25126, 25112, 25086, 25014,
+    24943, 24907, 24865, 24930, 24855, 24841, 24831, 24832, 24789, 24771, 24745, 24798,
+    24788, 24767, 24680, 24692, 24675, 24687, 24639, 24700, 24670, 24659, 24702, 24650,
+    24688, 24645, 24668, 24620, 24650, 24676, 24616, 24659, 24601, 24637, 24659, 24630,
+    24593, 24598, 24620, 24650, 24624, 24655, 24581, 24601, 24578, 24596, 24642, 24646,
+    24659, 24635, 24577, 24632, 24591, 24646, 24657, 24625, 24632, 24638, 24591, 24637,
+    24611, 24586, 24613, 24622, 24621, 24579, 24579, 24663, 24575, 24598, 24625, 24565,
+    24569, 24575, 24601, 24644, 24638, 24644, 24579, 24649, 24587, 24653, 24616, 24599,
+    24626, 24632, 24605, 24656, 24648, 24584, 24652, 24661, 24657, 24616, 24649, 27333,
+    29776, 31934, 34121, 35924, 37778, 39380, 40840, 42245, 43546, 44615, 45642, 46744,
+    47594, 48338, 49104, 49908, 50475, 51140, 51656, 52097, 52731, 52960, 53412, 53799,
+    54090, 54482, 54698, 54894, 55197, 55507, 55555, 55911, 55920, 56077, 56197, 56437,
+    56562, 56658, 56674, 56774, 56970, 56969, 57129, 57234, 57306, 57356, 57269, 57447,
+    57465, 57465, 57648, 57663, 57663, 57700, 57676, 57698, 57816, 57709, 57776, 57752,
+    57789, 57898, 57855, 57872, 57748, 57927, 57895, 57775, 57933, 57784, 57890, 57967,
+    57991, 57895, 57883, 57850, 57969, 57871, 57846, 58007, 57877, 57976, 57934, 57951,
+    57912, 58058, 57936, 57923, 57864, 58035, 58068, 57882, 58054, 57909, 58072, 57856,
+    57977, 57934, 57949, 57913, 58030, 58063, 57953, 57965, 57952, 58001, 57950, 57992,
+    58039, 57906, 57942, 57970, 57927, 58070, 57986, 58085, 58077, 58071, 57941, 58060,
+    58064, 57893, 58046, 58025, 57950, 58055, 57971, 57912, 55937, 54244, 52610, 50992,
+    49542, 48320, 47049, 46076, 45050, 44088, 43211, 42391, 41757, 40972, 40395, 39841,
+    39321, 38911, 38499, 37995, 37683, 37251, 36949, 36690, 36506, 36139, 36049, 35835,
+    35599, 35425, 35231, 35135, 34913, 34853, 34710, 34601, 34471, 34453, 34394, 34203,
+    34261, 34128, 34053, 34003, 33943, 33989, 33870, 33894, 33773, 33819, 33784, 33772,
+    33702, 33730, 33626, 33582, 33597, 33613, 33623, 33513, 33577, 33557, 33483, 33518,
+    33441, 33533, 33428, 33523, 33461, 33432, 33491, 33488, 33490, 33500, 33390, 33467,
+    33450, 33439, 33426, 33386, 33374, 33445, 33374, 33480, 33375, 33425, 33430, 33365,
+    33465, 33413, 33377, 33375, 33463, 33428, 33362, 33445, 33435, 33382, 33384, 33452,
+    33455, 33428, 33417, 33375, 33391, 33342, 33403, 33418, 33366, 35416, 37200, 38773,
+    40322, 41810, 43115, 44246, 45429, 46396, 47293, 48101, 49050, 49672, 50285, 50890,
+    51605, 52140, 52469, 52966, 53449, 53629, 54171, 54371, 54668, 55045, 55241, 55383,
+    55637, 55795, 56035, 56172, 56389, 56424, 56516, 56667, 56819, 56767, 56990, 57101,
+    57133, 57174, 57327, 57278, 57467, 57515, 57403, 57461, 57591, 57677, 57599, 57565,
+    57713, 57796, 57778, 57788, 57873, 57866, 57882, 57815, 57850, 57923, 57931, 56698,
+    55334, 54320, 53301, 52417, 51652, 50993, 50223, 49448, 49044, 48492, 47927, 47352,
+    47044, 46694, 46199, 45972, 45595, 45327, 45005, 44904, 44710, 44350, 44233, 44126,
+    43824, 43840, 43645, 43549, 43466, 43264, 43168, 43091, 42992, 42957, 42912, 42909,
+    42722, 42713, 42752, 42671, 42541, 42614, 42591, 42483, 42405, 42430, 42421, 42291,
+    42270, 42383, 42275, 42359, 42336, 42190, 42235, 42192, 42227, 42179, 42234, 42164,
+    42150, 42213, 42147, 42183, 42136, 42202, 42099, 42162, 42074, 43394, 44631, 45693,
+    46626, 47497, 48298, 49214, 49879, 50464, 51163, 51764, 52255, 52685, 52972, 53467,
+    53865, 54256, 54517, 54664, 54971, 55190, 55511, 55620, 55899, 55991, 56246, 56232,
+    56518, 56662, 56802, 56759, 56807, 56987, 57072, 57032, 57312, 57163, 57285, 57347,
+    57347, 57385, 57529, 57570, 57644, 57608, 57674, 57703, 57608, 57717, 57836, 57789,
+    57765, 57781, 57786, 57887, 57750, 57881, 57759, 57827, 57952, 57889, 57901, 57949,
+    57867, 57857, 57890, 57996, 57935, 57986, 57891, 57888, 57901, 57921, 58001, 58032,
+    58001, 58045, 58028, 58030, 57870, 57881, 58000, 57909, 57867, 57987, 58017, 57979,
+    57927, 57903, 58054, 57938, 57947, 57914, 57970, 58084, 58056, 57909, 57860, 57894,
+    57924, 58066, 58069, 57859, 58074, 57882, 57861, 57978, 57960, 58071, 58083, 58090,
+    57952, 57895, 57997, 57884, 57896, 58003, 57901, 58027, 57995, 57889, 57930, 57935,
+    57940, 58028, 57924, 57903, 57943, 57886, 58057, 57862, 58050, 58021, 57907, 57925,
+    58022, 57929, 58057, 57873, 57856, 58077, 57991, 57942, 57985, 58011, 58069, 58077,
+    58077, 58070, 57955, 58010, 57874, 57959, 57885, 57874, 58070, 57877, 57953, 58001,
+    57931, 57993, 58068, 57862, 57875, 58034, 57943, 57875, 57906, 57864, 57922, 58018,
+    58035, 58049, 57900, 57924, 57846, 58045, 57951, 57921, 54661, 51855, 49089, 46454,
+    44227, 42016, 40142, 38378, 36657, 35170, 33669, 32408, 31282, 30164, 29132, 28190,
+    27393, 26599, 25912, 25188, 24640, 24024, 23525, 23088, 22611, 22201, 21874, 21521,
+    21186, 20887, 20628, 20367, 20138, 19943, 19774, 19576, 19454, 19314, 19151, 19010,
+    18893, 18795, 18728, 18638, 18545, 18476, 18369, 18327, 18262, 18185, 18124, 18081,
+    18034, 18046, 17986, 17932, 17915, 17908, 17877, 17859, 17809, 17788, 17788, 17768,
+    17755, 17769, 17704, 17736, 17676, 17679, 17706, 17702, 17675, 17656, 17658, 17665,
+    17631, 17629, 17652, 17656, 17605, 17619, 17628, 17596, 17596, 17576, 17617, 17602,
+    17587, 17615, 17603, 17577, 17626, 17575, 17595, 17626, 17611, 17598, 20804, 23780,
+    26551, 29065, 31315, 33410, 35466, 37292, 38866, 40323, 41854, 43014, 44282, 45336,
+    46316, 47322, 48170, 48845, 49620, 50227, 50973, 51461, 51908, 52554, 52948, 53394,
+    53772, 54070, 54384, 54586, 54796, 55035, 55245, 55596, 55663, 55964, 56029, 56312,
+    56258, 56574, 56594, 56766, 56773, 56965, 56978, 57041, 57103, 57254, 57156, 57273,
+    57348, 57466, 57373, 57527, 57433, 57457, 57461, 57691, 57608, 57630, 57536, 57654,
+    57592, 57648, 57776, 57658, 57730, 57832, 57843, 57704, 57862, 57902, 57794, 57752,
+    57732, 57755, 57809, 57835, 57856, 57943, 57895, 57730, 57766, 57842, 57896, 57860,
+    57934, 57947, 57809, 57840, 57897, 57831, 57816, 57787, 57818, 57805, 57792, 57905,
+    57855, 57904, 57798, 57980, 57940, 57851, 57911, 57863, 57902, 57845, 57981, 57782,
+    57980, 57833, 57764, 57949, 57820, 57890, 57766, 57931, 57926, 57805, 57791, 57786,
+    57959, 57826, 57924, 57964, 57944, 57963, 57777, 57891, 57927, 57789, 57812, 57879,
+    57751, 57865, 57869, 57789, 57809, 57759, 57877, 57796, 57820, 57822, 57947, 57916,
+    57961, 57836, 57744, 57939, 57772, 57832, 57891, 57910, 57858, 57915, 57738, 57780,
+    57747, 57755, 57818, 57764, 57906, 57902, 57836, 57808, 57900, 57807, 57829, 57906,
+    57772, 57790, 57744, 57925, 57864, 57756, 57728, 57749, 57912, 57821, 57875, 57772,
+    57804, 57816, 57862, 57799, 57834, 57810, 57749, 57838, 57823, 57788, 57858, 57916,
+    57807, 57707, 57832, 57877, 57805, 57896, 57874, 57739, 57758, 57796, 57887, 57732,
+    57916, 57869, 57736, 57901, 57763, 57808, 57826, 57777, 57693, 57721, 57897, 57853,
+    57817, 57751, 57851, 57824, 57885, 57698, 57828, 57711, 57802, 57899, 57867, 57749,
+    57854, 57845, 57843, 57873, 57891, 57709, 57790, 57725, 57826, 57895, 57894, 57806,
+    57769, 57834, 57829, 57858, 57853, 57705, 57715, 57684, 57669, 57827, 57814, 57680,
+    57691, 57778, 57879, 57806, 57766, 57862, 57881, 57804, 57792, 57793, 57801, 57872,
+    57772, 57773, 57740, 57736, 57727, 57762, 57657, 57727, 57657, 57788, 57766, 57711,
+    57821, 57658, 54988, 52623, 50372, 48360, 46384, 44684, 42969, 41587, 40147, 38898,
+    37699, 36667, 35624, 34843, 33988, 33147, 32552, 31898, 31207, 30759, 30228, 29774,
+    29250, 28960, 28575, 28171, 27861, 27639, 27335, 27105, 26871, 26681, 26528, 26367,
+    26164, 26085, 25908, 25847, 25654, 25630, 25483, 25446, 25313, 25270, 25181, 25168,
+    25039, 25041, 24916, 24881, 24831, 24839, 24846, 24762, 24737, 24719, 24698, 24637,
+    24649, 24617, 24584, 24611, 24619, 24554, 24576, 24525, 24566, 24545, 24474, 24500,
+    24447, 24456, 24506, 24447, 24451, 24414, 24437, 24479, 24424, 24461, 24394, 24399,
+    24442, 24428, 24383, 24410, 24363, 24393, 24440, 24427, 24368, 24353, 24352, 24432,
+    24433, 24352, 27100, 29563, 31739, 33785, 35747, 37547, 39084, 40562, 41984, 43154,
+    44437, 45465, 46447, 47264, 48163, 48886, 49630, 50189, 50907, 51454, 51787, 52263,
+    52807, 53063, 53502, 53755, 54104, 54349, 54658, 54888, 55077, 55322, 55636, 55684,
+    55816, 55896, 56066, 56301, 56426, 56500, 56626, 56646, 56829, 56721, 56777, 57028,
+    56941, 57076, 56986, 57042, 57271, 57226, 57342, 57198, 57331, 57340, 57340, 57275,
+    57350, 57442, 57532, 57531, 57505, 57409, 57396, 57412, 57415, 57445, 57619, 57467,
+    57429, 57595, 57483, 57462, 57584, 57478, 57652, 57591, 57594, 57583, 57623, 57589,
+    57659, 57551, 57482, 57652, 57472, 57615, 57590, 57606, 57582, 57700, 57548, 57520,
+    57507, 57589, 57511, 57579, 57509, 57514, 57677, 57668, 57506, 57483, 57630, 57472,
+    57507, 57479, 57585, 57532, 57642, 57537, 57693, 57693, 57568, 57524, 57678, 57537,
+    57473, 57472, 57568, 57528, 57470, 57608, 57651, 57638, 57579, 57529, 57497, 57472,
+    57656, 57596, 57470, 57668, 57600, 57628, 57507, 57599, 57661, 57555, 57515, 57665,
+    57585, 57663, 57600, 57535, 57616, 57568, 57663, 57471, 57583, 57524, 57566, 57537,
+    57538, 57520, 57612, 57462, 57555, 57558, 57583, 57482, 57631, 57538, 57510, 57632,
+    57598, 57620, 57506, 57431, 57518, 57491, 57530, 57569, 55542, 53891, 52443, 50961,
+    49550, 48343, 47136, 46216, 45163, 44332, 43430, 42669, 42001, 41444, 40810, 40338,
+    39782, 39358, 38974, 38601, 38176, 37791, 37518, 37198, 37071, 36809, 36538, 36403,
+    36141, 36010, 35938, 35756, 35582, 35494, 35333, 35324, 35197, 35043, 34947, 34972,
+    34810, 34794, 34690, 34661, 34626, 34549, 34509, 34524, 34520, 34457, 34443, 34385,
+    34442, 34400, 34339, 34308, 34327, 34251, 34199, 34294, 34177, 34155, 34161, 34181,
+    34213, 34206, 34232, 34187, 34143, 34084, 34164, 34143, 34164, 34063, 34138, 34181,
+    34144, 36045, 37699, 39343, 40707, 42137, 43268, 44374, 45445, 46432, 47288, 48127,
+    48844, 49555, 50135, 50666, 51277, 51763, 52164, 52547, 53005, 53359, 53661, 53992,
+    54244, 54466, 54788, 54851, 55195, 55365, 55597, 55548, 55799, 56029, 56069, 56242,
+    56214, 56403, 56456, 56481, 56457, 56712, 56728, 56666, 56881, 56885, 56968, 56971,
+    56987, 57044, 57098, 56951, 56998, 57044, 57090, 57178, 57185, 57250, 57172, 57304,
+    57331, 57139, 57139, 57326, 57228, 57355, 57243, 57378, 57185, 57235, 57260, 57346,
+    57396, 57324, 57346, 57327, 57402, 57272, 57293, 57279, 57268, 57290, 57327, 57326,
+    57359, 57431, 57288, 57291, 57398, 57380, 57344, 57396, 57437, 57436, 57296, 57309,
+    57295, 57405, 57408, 57313, 57322, 57312, 57355, 57426, 57268, 57317, 57361, 57285,
+    57265, 57316, 57224, 57251, 57255, 57289, 57275, 57339, 57240, 57253, 57222, 57401,
+    57234, 57199, 57365, 57254, 57223, 57264, 57218, 57180, 57373, 57340, 57188, 57266,
+    57216, 57319, 57181, 57393, 57234, 57385, 57332, 57253, 57237, 57259, 57256, 57283,
+    57239, 57270, 57180, 57155, 57284, 57374, 57346, 57284, 57359, 57248, 57230, 57248,
+    57269, 57240, 57357, 57273, 57153, 57339, 57262, 57358, 57154, 57163, 57178, 57210,
+    57141, 57328, 57223, 57309, 57285, 57185, 57329, 57160, 57186, 57302, 57171, 57227,
+    57327, 57323, 57283, 57189, 57125, 57130, 57185, 57239, 57229, 57205, 57198, 57107,
+    57151, 57178, 57254, 57265, 57242, 57173, 57099, 57212, 57242, 57269, 57129, 57118,
+    57225, 54746, 52371, 50085, 48262, 46317, 44756, 43057, 41681, 40333, 39234, 38147,
+    37071, 36124, 35219, 34525, 33761, 33025, 32472, 31928, 31381, 30910, 30487, 30084,
+    29690, 29365, 28976, 28757, 28409, 28179, 28000, 27729, 27521, 27391, 27239, 27131,
+    26915, 26779, 26740, 26603, 26484, 26409, 26370, 26210, 26148, 26157, 26056, 26039,
+    25939, 25866, 25818, 25782, 25814, 25778, 25746, 25644, 25643, 25616, 25627, 25608,
+    25526, 25542, 25494, 25480, 25549, 25458, 25446, 25431, 25468, 25478, 25407, 25432,
+    25455, 25392, 25440, 25357, 25438, 25412, 25428, 25381, 25392, 25423, 25353, 25382,
+    25341, 25322, 25388, 25314, 25392, 25321, 25317, 25377, 25365, 25313, 25339, 25384,
+    25364, 25339, 25322, 25324, 25338, 25345, 25286, 25297, 25360, 25345, 25296, 27839,
+    30169, 32323, 34252, 36145, 37806, 39424, 40731, 42120, 43215, 44415, 45350, 46360,
+    47081, 47962, 48753, 49263, 49939, 50572, 50976, 51428, 51965, 52386, 52797, 52980,
+    53323, 53569, 54023, 54236, 54517, 54532, 54797, 54878, 55198, 55326, 55374, 55452,
+    55741, 55723, 55806, 55968, 56049, 56164, 56273, 56171, 56340, 56422, 56417, 56413,
+    56457, 56534, 56615, 56673, 53822, 51494, 49106, 46917, 44986, 43227, 41611, 40126,
+    38817, 37466, 36303, 35163, 34161, 33258, 32392, 31651, 31026, 30261, 29732, 29191,
+    28666, 28142, 27744, 27376, 27015, 26601, 26340, 26074, 25775, 25514, 25332, 25127,
+    24965, 24779, 24622, 24464, 24292, 24141, 24085, 23937, 23829, 23810, 23705, 23636,
+    23555, 23467, 23456, 23417, 23346, 23309, 23252, 23229, 23195, 23122, 23056, 23070,
+    23048, 23061, 22965, 22935, 22943, 22954, 22905, 22905, 22936, 22907, 22899, 22899,
+    22825, 22824, 22852, 22791, 22837, 22831, 22831, 22773, 22791, 22806, 22806, 22761,
+    22749, 22801, 22790, 22804, 22763, 22749, 22745, 22771, 22781, 22784, 22719, 22715,
+    22736, 22748, 22761, 22727, 22762, 22763, 22727, 22695, 22730, 22704, 22693, 22688,
+    22719, 22744, 22737, 22729, 22682, 22689, 22705, 22695, 22743, 22754, 22723, 22738,
+    22753, 22757, 22718, 22682, 22719, 22738, 22699, 22717, 22745, 22741, 22696, 25443,
+    27951, 30308, 32318, 34376, 36080, 37738, 39332, 40660, 42047, 43224, 44289, 45238,
+    46165, 47070, 47813, 48467, 49171, 49693, 50300, 50819, 51249, 51730, 52178, 52454,
+    52790, 53182, 53356, 53801, 53934, 54140, 54320, 54472, 54733, 54830, 55006, 55155,
+    55213, 55442, 55427, 55571, 55696, 55843, 55857, 55830, 55867, 56028, 56083, 56127,
+    56087, 56297, 56261, 56296, 56326, 56430, 56279, 56503, 56446, 56404, 56387, 56377,
+    56538, 56603, 56418, 56579, 56591, 56474, 56610, 56474, 56646, 56546, 56658, 56650,
+    56486, 56670, 56702, 56576, 56711, 56549, 56637, 56577, 56614, 56594, 56556, 56687,
+    56599, 56589, 56516, 56588, 56710, 56537, 56638, 56647, 56514, 56710, 56624, 56578,
+    56511, 56536, 56607, 56716, 56592, 56576, 56622, 56615, 56685, 56657, 56602, 56649,
+    56694, 56696, 56671, 56628, 56577, 56664, 56481, 56673, 56613, 56559, 56534, 56627,
+    56661, 56470, 56600, 56507, 56490, 56474, 56684, 56563, 56680, 56658, 56535, 56500,
+    56511, 56560, 56447, 56489, 56464, 56604, 56487, 56599, 56584, 56489, 56639, 56586,
+    56492, 56531, 56625, 56525, 56439, 56453, 56511, 56594, 56620, 56482, 56626, 56494,
+    56598, 56629, 56565, 56454, 56593, 56500, 56543, 56429, 56611, 56502, 56573, 56591,
+    56518, 56453, 56513, 56398, 56424, 56537, 56520, 56465, 56416, 56386, 56440, 56455,
+    56591, 56543, 56382, 56378, 56418, 56514, 56552, 56560, 56423, 56379, 56559, 56420,
+    56478, 56386, 56346, 56369, 56400, 56525, 56464, 56413, 56520, 56401, 56447, 56453,
+    56492, 56473, 56482, 56381, 56543, 56472, 56368, 56446, 56483, 56367, 56508, 56440,
+    56483, 56348, 56306, 56440, 56491, 56470, 56487, 56305, 56496, 56483, 56435, 56426,
+    56332, 56491, 56476, 56481, 56303, 56495, 56384, 56280, 56437, 56345, 56457, 56357,
+    56321, 56429, 56275, 56277, 56257, 56331, 56340, 56467, 56279, 56294, 56377, 56340,
+    56250, 56254, 56391, 56312, 56290, 56357, 56281, 56277, 56234, 56447, 56283, 56325,
+    56313, 56404, 56299, 56325, 56407, 56392, 56369, 56323, 56265, 52851, 49879, 47060,
+    44338, 41983, 39803, 37736, 35825, 34126, 32577, 31161, 29764, 28540, 27412, 26361,
+    25411, 24499, 23647, 22891, 22221, 21612, 21017, 20507, 19993, 19575, 19157, 18769,
+    18414, 18083, 17723, 17484, 17227, 16996, 16780, 16603, 16406, 16249, 16067, 15966,
+    15961, 15934, 15941, 15923, 15938, 15904, 15913, 15901, 15898, 15920, 15911, 15899,
+    15915, 15908, 15924, 15887, 15934, 15924, 15897, 15916, 15891, 15904, 15895, 15932,
+    15893, 15939, 15883, 15876, 15891, 15897, 15935, 15880, 15889, 15871, 15882, 15920,
+    15924, 15886, 15887, 15913, 15924, 15901, 15880, 15914, 15863, 15883, 15918, 15866,
+    15880, 15900, 15908, 15860, 15909, 15883, 15875, 15892, 15866, 15896, 15904, 15879,
+    15886, 15866, 15854, 15893, 15870, 15862, 15896, 15902, 15876, 15882, 15864, 15858,
+    15844, 15846, 15857, 15892, 15883, 15844, 15865, 15841, 15845, 15869, 15861, 15841,
+    15878, 15850, 15868, 15838, 15848, 15850, 15861, 15844, 15893, 15837, 15889, 15885,
+    15874, 15868, 15836, 15891, 15858, 15883, 15843, 15850, 15849, 15885, 15862, 15862,
+    15871, 15847, 15864, 15829, 15844, 15860, 15868, 15877, 15829, 15848, 15865, 15866,
+    15855, 15836, 15879, 15827, 15872, 15884, 15844, 15883, 15834, 15856, 15882, 15836,
+    15870, 15855, 15871, 15834, 15840, 15834, 15867, 15841, 15851, 15860, 15869, 15869,
+    15856, 15841, 15863, 15847, 15858, 15830, 15841, 15834, 15865, 15835, 15839, 15872,
+    15847, 15868, 15888, 15873, 15842, 15861, 15849, 15866, 15846, 15864, 15851, 15842,
+    15876, 15835, 15855, 15838, 15845, 15888, 15882, 15894, 15894, 15853, 15858, 15877,
+    15864, 15849, 15879, 15882, 15890, 15894, 15891, 15887, 15899, 15874, 15854, 15863,
+    15892, 15863, 15883, 15848, 15846, 15887, 15856, 15862, 15856, 15907, 15890, 15849,
+    15869, 15908, 15885, 15859, 15870, 15877, 15879, 15889, 15875, 15869, 15917, 15913,
+    15905, 15879, 15883, 15896, 15920, 15901, 15872, 15881, 15879, 15909, 15889, 15890,
+    15925, 15878, 15880, 15906, 15897, 15886, 15919, 15927, 15879, 15875, 15904, 15931,
+    15917, 15900, 15903, 15926, 15914, 15894, 15939, 15918, 15917, 15912, 15929, 15913,
+    15925, 15921, 15932, 15915, 15920, 15927, 15915, 15901, 15949, 15951, 15960, 15942,
+    15956, 15930, 15906, 15921, 15951, 15906, 15952, 15917, 15946, 15915, 15918, 15954,
+    15939, 15962, 15975, 15972, 15961, 15933, 15966, 15944, 15928, 15942, 15937, 15974,
+    15972, 15976, 15957, 15971, 15969, 15942, 15989, 15962, 15958, 15950, 15954, 15992,
+    15971, 15965, 15955, 15966, 15957, 15986, 15993, 15994, 15971, 15960, 15971, 15981,
+    15976, 16014, 16010, 15983, 16004, 16012, 16031, 16026, 16019, 15994, 16025, 15988,
+    16037, 15980, 16034, 16041, 16045, 15988, 15989, 16031, 16013, 16055, 16015, 16055,
+    16047, 16054, 16017, 16058, 16027, 16068, 16049, 16064, 16056, 16042, 16026, 16014,
+    16035, 16024, 16083, 16060, 16076, 16054, 16080, 16086, 16074, 16039, 16079, 16088,
+    16073, 16095, 16080, 16051, 16086, 16089, 16089, 16057, 16087, 16065, 16085, 16081,
+    16060, 16118, 16121, 16107, 16072, 16101, 16120, 16076, 16092, 16102, 16135, 16087,
+    16125, 16105, 16097, 16132, 16126, 16132, 16090, 16092, 16119, 16133, 16116, 16118,
+    16132, 16143, 16113, 16121, 16168, 16165, 16115, 16118, 16147, 16175, 16142, 16145,
+    16179, 16153, 16158, 16132, 16180, 16150, 16147, 16140, 16176, 16167, 16192, 16177,
+    16175, 16182, 16208, 16199, 16161, 16164, 16193, 16221, 16219, 16207, 16200, 16228,
+    16220, 16183, 16232, 16215, 16236, 16212, 16246, 16237, 16242, 16232, 16210, 16202,
+    16239, 16241, 16256, 16209, 16207, 16266, 16239, 16259, 16262, 16278, 16233, 16251,
+    16272, 16255, 16229, 16279, 16286, 16242, 16250, 16251, 16267, 16278, 16249, 16278,
+    16272, 16306, 16288, 16268, 16285, 16311, 16298, 16292, 16268, 16289, 16320, 16309,
+    16288, 16305, 16319, 16280, 16301, 16288, 16336, 16308, 16296, 16353, 16349, 16325,
+    16331, 16312, 16341, 16343, 16364, 16356, 16322, 16332, 16328, 16376, 16363, 16342,
+    16361, 16369, 16392, 16337, 16398, 16379, 16375, 16343, 16394, 16387, 16398, 16390,
+    16395, 16380, 16408, 16385, 16368, 16406, 16368, 16386, 16419, 16392, 16400, 16421,
+    16401, 16392, 16422, 16390, 16408, 16447, 16421, 16453, 16426, 16459, 16410, 16455,
+    16431, 16439, 16436, 16436, 16460, 16426, 16455, 16467, 16451, 16433, 16454, 16457,
+    16459, 16436, 16440, 16477, 16480, 16493, 16468, 16488, 16494, 16499, 16472, 16458,
+    16518, 16516, 16522, 16489, 16530, 16507, 16484, 16491, 16490, 16500, 16504, 16538,
+    16522, 16538, 16551, 16512, 16505, 16498, 16525, 16520, 16568, 16537, 16539, 16537,
+    16574, 16536, 16567, 16571, 16528, 16536, 16537, 16530, 16594, 16554, 16576, 16555,
+    16557, 16575, 16560, 16546, 16571, 16568, 16556, 16620, 16577, 16584, 16561, 16579,
+    16589, 16597, 16588, 16592, 16595, 16611, 16586, 16629, 16627, 16611, 16634, 16654,
+    16616, 16627, 16635, 16657, 16633, 16635, 16606, 16649, 16620, 16670, 16666, 16641,
+    16663, 16620, 16622, 16676, 16656, 16692, 16642, 16647, 16670, 16661, 16658, 16650,
+    16668, 16700, 16649, 16668, 16694, 16716, 16655, 16676, 16705, 16709, 16662, 16679,
+    16701, 16677, 16685, 16724, 16731, 16735, 16711, 16723, 16689, 16741, 16709, 16725,
+    16754, 16735, 16698, 16752, 16711, 16725, 16730, 16758, 16748, 16716, 16745, 16764,
+    16763, 16755, 16728, 16732, 16771, 16787, 16730, 16760, 16793, 16770, 16799, 16757,
+    16800, 16786, 16752, 16794, 16769, 16788, 16809, 16806, 16762, 16789, 16781, 16784,
+    16807, 16798, 16781, 16804, 16828, 16779, 16771, 16813, 16821, 16805, 16801, 16808,
+    16823, 16808, 16833, 16852, 16836, 16841, 16849, 16814, 16834, 16848, 16863, 16846,
+    16820, 16859, 16825, 16850, 16872, 16871, 16825, 16825, 16848, 16863, 16838, 16832,
+    16865, 16884, 16840, 16834, 16849, 16851, 16870, 16846, 16901, 16859, 16844, 16897,
+    16887, 16858, 16850, 16851, 16873, 16883, 16860, 16860, 16893, 16889, 16912, 16876,
+    16906, 16868, 16913, 16878, 16928, 16873, 16906, 16909, 16912, 16895, 16878, 16905,
+    16898, 16914, 16911, 16943, 16942, 16899, 16920, 16893, 16937, 16897, 16935, 16912,
+    16921, 16926, 16913, 16942, 16900, 16922, 16935, 16928, 16916, 16946, 16940, 16937,
+    16932, 16957, 16973, 16926, 16922, 16953, 16963, 16958, 16947, 16924, 16949, 16953,
+    16981, 16960, 16963, 16965, 16973, 16938, 16946, 16933, 16945, 16954, 16936, 16984,
+    16955, 16973, 16944, 17004, 16988, 17005, 16949, 16986, 16948, 16948, 17007, 16996,
+    17016, 17001, 16980, 16981, 16972, 16984, 16991, 17022, 17019, 17014, 16958, 17021,
+    16979, 17003, 16979, 17007, 17014, 17015, 16996, 17004, 17033, 17032, 17036, 16993,
+    17038, 17019, 17003, 16995, 16995, 16988, 17027, 16987, 17004, 16991, 17038, 17021,
+    17016, 17036, 17023, 17047, 17020, 17039, 17041, 17030, 17006, 17017, 17040, 17045,
+    17022, 17030, 17035, 17009, 17041, 16991, 17021, 17006, 17011, 17039, 17039, 16996,
+    17020, 17057, 17029, 17062, 17002, 17016, 17052, 17045, 17054, 17061, 17014, 17020,
+    17048, 17020, 17023, 17015, 17036, 17015, 17051, 17053, 17035, 17060, 17012, 17063,
+    17020, 17057, 17027, 17047, 17021, 17050, 17011, 17007, 17037, 17039, 17063, 17065,
+    17022, 17040, 17024, 17011, 17055, 17012, 17049, 17020, 17064, 17014, 17068, 17059,
+    17048, 17069, 17050, 17057, 17010, 17040, 17037, 17016, 17074, 17067, 17026, 17072,
+    17010, 17047, 17026, 17038, 17059, 17063, 17019, 17070, 17040, 17032, 17037, 17068,
+    17057, 17021, 17057, 17017, 17059, 17019, 17018, 17029, 17019, 17024, 17055, 17041,
+    17008, 17043, 17032, 17047, 17037, 17036, 17043, 17060, 17021, 17031, 17067, 17018,
+    17028, 17026, 17044, 17038, 17063, 17038, 17052, 17017, 17026, 17053, 17019, 17002,
+    17057, 17039, 17000, 17054, 17059, 17035, 16999, 17011, 17053, 17017, 16999, 17053,
+    17009, 17019, 17011, 17017, 16991, 17009, 16996, 17003, 17018, 17002, 16991, 17022,
+    16995, 17040, 16980, 16988, 16997, 16981, 17029, 16992, 16979, 17015, 17021, 16980,
+    17006, 17026, 16998, 16998, 16996, 16980, 17026, 16988, 17023, 16975, 16985, 16969,
+    16959, 16993, 16965, 16970, 16969, 16969, 16968, 16961, 16975, 16959, 16949, 16964,
+    16998, 16987, 16961, 16958, 16981, 16966, 16966, 16984, 16966, 16960, 16946, 16986,
+    16992, 16961, 16943, 16933, 16973, 16973, 16929, 16968, 16927, 16937, 16933, 16953,
+    16952, 16945, 16927, 16953, 16971, 16929, 16965, 16916, 16925, 16956, 16942, 16961,
+    16911, 16913, 16940, 16958, 16909, 16912, 16921, 16916, 16957, 16924, 16933, 16888,
+    16887, 16916, 16925, 16883, 16928, 16933, 16878, 16910, 16901, 16921, 16870, 16919,
+    16914, 16883, 16916, 16876, 16870, 16881, 16873, 16885, 16919, 16886, 16858, 16854,
+    16869, 16857, 16848, 16890, 16840, 16842, 16857, 16845, 16858, 16885, 16835, 16880,
+    16826, 16880, 16857, 16854, 16884, 16861, 16846, 16868, 16836, 16830, 16838, 16862,
+    16860, 16862, 16843, 16838, 16852, 16854, 16853, 16816, 16811, 16815, 16834, 16826,
+    16821, 16827, 16794, 16783, 16775, 16800, 16769, 16810, 16784, 16816, 16810, 16787,
+    16764, 16770, 16752, 16766, 16799, 16786, 16783, 16749, 16781, 16770, 16785, 16750,
+    16789, 16791, 16738, 16774, 16765, 16774, 16767, 16738, 16711, 16729, 16769, 16740,
+    16726, 16751, 16752, 16747, 16731, 16720, 16689, 16703, 16738, 16691, 16733, 16736,
+    16698, 16705, 16684, 16669, 16722, 16718, 16681, 16709, 16705, 16679, 16675, 16648,
+    16694, 16698, 16649, 16658, 16687, 16676, 16687, 16675, 16665, 16671, 16657, 16658,
+    16623, 16643, 16664, 16651, 16665, 16641, 16649, 16658, 16656, 16615, 16620, 16611,
+    16633, 16591, 16629, 16623, 16609, 16573, 16572, 16616, 16623, 16592, 16597, 16578,
+    16555, 16596, 16603, 16605, 16542, 16598, 16538, 16530, 16585, 16576, 16585, 16535,
+    16539, 16543, 16542, 16566, 16564, 16550, 16554, 16551, 16533, 16513, 16507, 16493,
+    16539, 16532, 16487, 16511, 16510, 16497, 16510, 16510, 16487, 16494, 16454, 16469,
+    16504, 16477, 16498, 16441, 16440, 16450, 16449, 16452, 16482, 16426, 16434, 16453,
+    16475, 16419, 16463, 16458, 16434, 16448, 16440, 16408, 16433, 16425, 16424, 16424,
+    16378, 16428, 16402, 16425, 16419, 16381, 16389, 16396, 16368, 16358, 16354, 16358,
+    16371, 16400, 16336, 16351, 16350, 16358, 16329, 16333, 16343, 16333, 16338, 16356,
+    16349, 16334, 16338, 16344, 16327, 16324, 16337, 16300, 16312, 16310, 16333, 16316,
+    16321, 16274, 16307, 16305, 16276, 16264, 16302, 16270, 16263, 16240, 16272, 16242,
+    16260, 16249, 16277, 16244, 16217, 16213, 16249, 16258, 16223, 16214, 16221, 16240,
+    16218, 16243, 16195, 16209, 16199, 16170, 16214, 16199, 16191, 16194, 16189, 16172,
+    16171, 16191, 16191, 16191, 16166, 16181, 16166, 16122, 16132, 16115, 16117, 16113,
+    16111, 16119, 16153, 16101, 16130, 16105, 16094, 16118, 16139, 16134, 16111, 16077,
+    16119, 16075, 16068, 16111, 16060, 16104, 16094, 16091, 16062, 16046, 16048, 16027,
+    16027, 16050, 16075, 16043, 16012, 16008, 16056, 16022, 16006, 16047, 16018, 16009,
+    16009, 15995, 16006, 16026, 16019, 16024, 16017, 16015, 15958, 15998, 15966, 15982,
+    15987, 15975, 15967, 15955, 15952, 15967, 15947, 15964, 15953, 15940, 15937, 15916,
+    15945, 15954, 15897, 15945, 15911, 15939, 15892, 15899, 15931, 15913, 15925, 15903,
+    15885, 15878, 15861, 15869, 15856, 15891, 15892, 15832, 15868, 15848, 15831, 15837,
+    15845, 15871, 15813, 15824, 15825, 15820, 15836, 15839, 15845, 15826, 15810, 15814,
+    15803, 15808, 15774, 15809, 15769, 15796, 15800, 15775, 15792, 15797, 15794, 15790,
+    15758, 15740, 15754, 15761, 15760, 15767, 15722, 15737, 15743, 15716, 15747, 15708,
+    15745, 15729, 15739, 15705, 15691, 15725, 15691, 15711, 15688, 15669, 15674, 15701,
+    15650, 15686, 15690, 15689, 15636, 15634, 15667, 15671, 15670, 15633, 15629, 15641,
+    15620, 15659, 15626, 15645, 15643, 15625, 15640, 15610, 15593, 15588, 15629, 15589,
+    15582, 15601, 15610, 15614, 15603, 15609, 15555, 15593, 15573, 15594, 15573, 15588,
+    15531, 15561, 15531, 15516, 15537, 15509, 15515, 15553, 15500, 15517, 15544, 15542,
+    15544, 15503, 15492, 15485, 15527, 15508, 15502, 15493, 15492, 15504, 15493, 15457,
+    15486, 15468, 15456, 15491, 15470, 15447, 15473, 15436, 15431, 15445, 15451, 15448,
+    15425, 15402, 15453, 15414, 15414, 15405, 15429, 15399, 15440, 15419, 15413, 15370,
+    15423, 15420, 15369, 15408, 15392, 15394, 15371, 15384, 15370, 15343, 15367, 15393,
+    15337, 15333, 15332, 15344, 15320, 15345, 15321, 15330, 15334, 15324, 15342, 15345,
+    15348, 15327, 15308, 15300, 15326, 15293, 15304, 15323, 15312, 15265, 15315, 15315,
+    15314, 15271, 15262, 15252, 15252, 15273, 15290, 15286, 15289, 15250, 15261, 15258,
+    15274, 15262, 15233, 15261, 15264, 15260, 15252, 15245, 15251, 15234, 15222, 15199,
+    15192, 15206, 15176, 15178, 15191, 15169, 15191, 15189, 15164, 15169, 15162, 15183,
+    15161, 15180, 15182, 15148, 15193, 15175, 15170, 15144, 15150, 15144, 15167, 15148,
+    15152, 15111, 15111, 15155, 15106, 15143, 15104, 15098, 15150, 15088, 15144, 15096,
+    15085, 15082, 15109, 15114, 15092, 15097, 15114, 15076, 15089, 15115, 15073, 15070,
+    15099, 15056, 15074, 15053, 15079, 15065, 15058, 15073, 15054, 15056, 15074, 15075,
+    15042, 15016, 15019, 15052, 15065, 15029, 15002, 15015, 15048, 15021, 15010, 15044,
+    15001, 15041, 15020, 15033, 15000, 15013, 15007, 15011, 14994, 15002, 14969, 14991,
+    14978, 14985, 14975, 14983, 14964, 14948, 14974, 14968, 14974, 14943, 14988, 14985,
+    14985, 14974, 14949, 14955, 14919, 14947, 14968, 14923, 14914, 14961, 14947, 14936,
+};
@@ -0,0 +1,219 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for adaptive_sampler, including a replay of the partly
+ * cloudy trace against a fixed interval that takes the same number of
+ * readings.
+ *
+ * Run with: pio test -e native -f test_adaptive_sampler
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "adaptive_sampler.h"
+#include "../data/trace_partly_cloudy.h"
+
+#define MIN_S 5
+#define MAX_S 60
+
+/**
+ * @brief Outcome of sampling the trace with some schedule
+ */
+typedef struct {
+    int readings;
+    double mean_abs_error_lux;      // Linear interpolation between readings vs. every trace second
+} replay_result_t;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static double trace_lux(int64_t t_ms) {
+    int64_t s = t_ms / 1000;
+    return trace_partly_cloudy[s < TRACE_PARTLY_CLOUDY_SECONDS ? s : TRACE_PARTLY_CLOUDY_SECONDS - 1];
+}
+
+/**
+ * @brief Add the interpolation error over one gap between readings
+ */
+static double gap_error(int64_t from_ms, double from_lux, int64_t to_ms, double to_lux) {
+    double error = 0.0;
+    for (int64_t s = (from_ms + 999) / 1000; s * 1000 < to_ms; s++) {
+        double fraction = (double)(s * 1000 - from_ms) / (double)(to_ms - from_ms);
+        double estimate = from_lux + (to_lux - from_lux) * fraction;
+        error += fabs(estimate - trace_partly_cloudy[s]);
+    }
+    return error;
+}
+
+static replay_result_t replay_adaptive(int64_t *end_ms) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+
+    int64_t t_ms = 0;
+    double lux = trace_lux(0);
+    adaptive_sampler_update(&sampler, (float)lux);
+    replay_result_t result = { 1, 0.0 };
+    double error = 0.0;
+    for (;;) {
+        // Next wall-clock multiple of the interval, as the sensor task schedules it
+        uint32_t interval_ms = adaptive_sampler_interval_ms(&sampler);
+        TEST_ASSERT_TRUE(adaptive_sampler_is_aligned(interval_ms / 1000));
+        TEST_ASSERT_EQUAL_INT(0, interval_ms % 1000);
+        int64_t next_ms = (t_ms / interval_ms + 1) * interval_ms;
+        if (next_ms >= TRACE_PARTLY_CLOUDY_SECONDS * 1000LL) {
+            break;
+        }
+        double next_lux = trace_lux(next_ms);
+        error += gap_error(t_ms, lux, next_ms, next_lux);
+        t_ms = next_ms;
+        lux = next_lux;
+        result.readings++;
+        adaptive_sampler_update(&sampler, (float)lux);
+    }
+    *end_ms = t_ms;
+    result.mean_abs_error_lux = error / (double)(t_ms / 1000);
+    return result;
+}
+
+static replay_result_t replay_fixed(int readings, int64_t end_ms) {
+    replay_result_t result = { readings, 0.0 };
+    double error = 0.0;
+    for (int i = 1; i < readings; i++) {
+        int64_t from_ms = end_ms * (i - 1) / (readings - 1);
+        int64_t to_ms = end_ms * i / (readings - 1);
+        error += gap_error(from_ms, trace_lux(from_ms), to_ms, trace_lux(to_ms));
+    }
+    result.mean_abs_error_lux = error / (double)(end_ms / 1000);
+    return result;
+}
+
+static void test_first_reading_keeps_minimum(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+    TEST_ASSERT_EQUAL_INT(MIN_S * 1000, adaptive_sampler_interval_ms(&sampler));
+    adaptive_sampler_update(&sampler, 1000.0f);
+    TEST_ASSERT_EQUAL_INT(MIN_S * 1000, adaptive_sampler_interval_ms(&sampler));
+}
+
+static void test_steady_light_stretches_to_maximum(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+    uint32_t previous = adaptive_sampler_interval_ms(&sampler);
+    for (int i = 0; i < 20; i++) {
+        adaptive_sampler_update(&sampler, 1000.0f);
+        TEST_ASSERT_TRUE(adaptive_sampler_interval_ms(&sampler) >= previous);
+        previous = adaptive_sampler_interval_ms(&sampler);
+    }
+    TEST_ASSERT_EQUAL_INT(MAX_S * 1000, previous);
+}
+
+static void test_fast_change_shortens_interval(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+    for (int i = 0; i < 20; i++) {
+        adaptive_sampler_update(&sampler, 1000.0f);
+    }
+    adaptive_sampler_update(&sampler, 500.0f);
+    TEST_ASSERT_TRUE(adaptive_sampler_interval_ms(&sampler) < MAX_S * 1000);
+    for (int i = 0; i < 10; i++) {
+        adaptive_sampler_update(&sampler, (i % 2) ? 1000.0f : 500.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(MIN_S * 1000, adaptive_sampler_interval_ms(&sampler));
+}
+
+static void test_dim_noise_is_not_change(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+    // A 0.3 lx wobble at dusk is 30% of the level but small against the 20 lx floor
+    for (int i = 0; i < 20; i++) {
+        adaptive_sampler_update(&sampler, (i % 2) ? 1.0f : 1.3f);
+    }
+    TEST_ASSERT_EQUAL_INT(MAX_S * 1000, adaptive_sampler_interval_ms(&sampler));
+}
+
+static void test_equal_bounds_are_fixed(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, 15, 15);
+    for (int i = 0; i < 20; i++) {
+        adaptive_sampler_update(&sampler, (i % 3) ? 100.0f : 40000.0f);
+        TEST_ASSERT_EQUAL_INT(15000, adaptive_sampler_interval_ms(&sampler));
+    }
+}
+
+static void test_intervals_divide_an_hour(void) {
+    adaptive_sampler_t sampler;
+    adaptive_sampler_init(&sampler, MIN_S, MAX_S);
+    // Stretching by half from the minimum walks the aligned intervals
+    static const uint32_t expected_s[] = { 10, 15, 30, 60 };
+    adaptive_sampler_update(&sampler, 1000.0f);
+    for (int i = 0; i < (int)(sizeof(expected_s) / sizeof(expected_s[0])); i++) {
+        adaptive_sampler_update(&sampler, 1000.0f);
+        TEST_ASSERT_EQUAL_INT(expected_s[i] * 1000, adaptive_sampler_interval_ms(&sampler));
+    }
+    // Halving 60 s lands on 30 s, halving 15 s on 6 s rather than 7.5 s
+    adaptive_sampler_update(&sampler, 500.0f);
+    TEST_ASSERT_EQUAL_INT(30000, adaptive_sampler_interval_ms(&sampler));
+    adaptive_sampler_update(&sampler, 1000.0f);
+    TEST_ASSERT_EQUAL_INT(15000, adaptive_sampler_interval_ms(&sampler));
+    adaptive_sampler_update(&sampler, 500.0f);
+    TEST_ASSERT_EQUAL_INT(6000, adaptive_sampler_interval_ms(&sampler));
+
+    // Bounds that don't divide an hour are rounded inward
+    adaptive_sampler_init(&sampler, 7, 50);
+    TEST_ASSERT_EQUAL_INT(10000, adaptive_sampler_interval_ms(&sampler));
+    for (int i = 0; i < 20; i++) {
+        adaptive_sampler_update(&sampler, 1000.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(30000, adaptive_sampler_interval_ms(&sampler));
+    TEST_ASSERT_TRUE(adaptive_sampler_is_aligned(240));
+    TEST_ASSERT_FALSE(adaptive_sampler_is_aligned(45));
+}
+
+/**
+ * @brief Replay the trace and compare with fixed intervals
+ *
+ * The adaptive schedule only reacts after the light has moved, so at the
+ * same number of readings it is about as accurate as spreading them evenly;
+ * what it buys is far fewer readings than the minimum interval would take.
+ */
+static void test_replay_against_fixed_interval(void) {
+    int64_t end_ms;
+    replay_result_t adaptive = replay_adaptive(&end_ms);
+    replay_result_t fixed = replay_fixed(adaptive.readings, end_ms);
+    replay_result_t fixed_min = replay_fixed((int)(end_ms / (MIN_S * 1000)) + 1, end_ms);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "adaptive %d-%d s: %d readings, %.0f lx mean error; fixed %.1f s: %.0f lx; fixed %d s: %d readings, %.0f lx",
+             MIN_S, MAX_S, adaptive.readings, adaptive.mean_abs_error_lux,
+             end_ms / 1000.0 / (adaptive.readings - 1), fixed.mean_abs_error_lux,
+             MIN_S, fixed_min.readings, fixed_min.mean_abs_error_lux);
+    TEST_MESSAGE(msg);
+
+    // Far fewer readings than sampling at the minimum interval throughout...
+    TEST_ASSERT_TRUE(adaptive.readings * 4 < fixed_min.readings);
+    // ...and no real loss against spreading the same number evenly
+    TEST_ASSERT_TRUE(adaptive.mean_abs_error_lux < 1.15 * fixed.mean_abs_error_lux);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_reading_keeps_minimum);
+    RUN_TEST(test_steady_light_stretches_to_maximum);
+    RUN_TEST(test_fast_change_shortens_interval);
+    RUN_TEST(test_dim_noise_is_not_change);
+    RUN_TEST(test_equal_bounds_are_fixed);
+    RUN_TEST(test_intervals_divide_an_hour);
+    RUN_TEST(test_replay_against_fixed_interval);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for lux_range against a simulated BH1750.
+ *
+ * The simulated sensor returns count = lux * 1.2 * MTreg / 69, doubled in
+ * HIGH2 mode, rounded down to 4 lx steps in LOW mode and clipped at full
+ * scale, which is the datasheet's typical response.
+ *
+ * Run with: pio test -e native -f test_lux_range
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "lux_range.h"
+
+#define FULL_SCALE 65535
+#define MAX_READINGS_TO_CONVERGE 4
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static uint16_t simulated_count(lux_range_setting_t setting, double lux) {
+    double count = lux * 1.2 * setting.mtreg / 69.0;
+    if (setting.resolution == LUX_RES_HIGH2) {
+        count *= 2.0;
+    }
+    if (setting.resolution == LUX_RES_LOW) {
+        double step = 4.0 * 1.2 * setting.mtreg / 69.0;
+        count = floor(count / step) * step;
+    }
+    return count >= FULL_SCALE ? FULL_SCALE : (uint16_t)floor(count);
+}
+
+/**
+ * @brief Lux represented by one count, independently of the module
+ */
+static double resolution_lux(lux_range_setting_t setting) {
+    double lux = 69.0 / (1.2 * setting.mtreg);
+    if (setting.resolution == LUX_RES_HIGH2) {
+        lux /= 2.0;
+    }
+    return setting.resolution == LUX_RES_LOW ? lux * 4.0 * 1.2 * setting.mtreg / 69.0 : lux;
+}
+
+/**
+ * @brief One reading as the sensor task takes it, re-measuring while saturated
+ *
+ * @param saturated Set if the first measurement was clipped
+ */
+static float take_reading(lux_range_t *range, double lux, bool *saturated) {
+    lux_range_setting_t setting = lux_range_setting(range);
+    uint16_t raw = simulated_count(setting, lux);
+    bool again = lux_range_update(range, raw);
+    if (saturated != NULL) {
+        *saturated = again;
+    }
+    while (again) {
+        setting = lux_range_setting(range);
+        raw = simulated_count(setting, lux);
+        again = lux_range_update(range, raw);
+    }
+    return lux_range_to_lux(setting, raw);
+}
+
+static void test_conversion_matches_datasheet(void) {
+    lux_range_setting_t high = { LUX_RES_HIGH, LUX_RANGE_MTREG_DEFAULT };
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1000.0f, lux_range_to_lux(high, 1200));
+    lux_range_setting_t high2_max = { LUX_RES_HIGH2, LUX_RANGE_MTREG_MAX };
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 69.0f / (1.2f * 254.0f) / 2.0f, lux_range_to_lux(high2_max, 1));
+    TEST_ASSERT_EQUAL_INT(180, lux_range_conversion_ms(high));
+    TEST_ASSERT_EQUAL_INT(11, lux_range_conversion_ms((lux_range_setting_t){ LUX_RES_LOW, LUX_RANGE_MTREG_MIN }));
+}
+
+/**
+ * @brief Every level from 0.1 lx to 120 klx settles within a few readings,
+ * to within one count of the step it settles on
+ */
+static void test_converges_across_range(void) {
+    for (double lux = 0.1; lux <= 120000.0; lux *= 1.25) {
+        lux_range_t range;
+        lux_range_init(&range);
+        float measured = 0.0f;
+        for (int i = 0; i < MAX_READINGS_TO_CONVERGE; i++) {
+            measured = take_reading(&range, lux, NULL);
+        }
+        double tolerance = resolution_lux(lux_range_setting(&range)) * 1.01;
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%.1f lx", lux);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, lux, measured, msg);
+    }
+}
+
+/**
+ * @brief A jump from deep dusk to full sun and back settles just as quickly
+ */
+static void test_converges_after_jumps(void) {
+    static const double jumps[] = { 0.1, 120000.0, 0.1, 54000.0, 3.0, 120000.0 };
+    lux_range_t range;
+    lux_range_init(&range);
+    for (size_t j = 0; j < sizeof(jumps) / sizeof(jumps[0]); j++) {
+        float measured = 0.0f;
+        for (int i = 0; i < MAX_READINGS_TO_CONVERGE; i++) {
+            measured = take_reading(&range, jumps[j], NULL);
+        }
+        double tolerance = resolution_lux(lux_range_setting(&range)) * 1.01;
+        char msg[64];
+        snprintf(msg, sizeof(msg), "jump to %.1f lx", jumps[j]);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, jumps[j], measured, msg);
+    }
+}
+
+/**
+ * @brief A steady light level never makes the step flip back and forth
+ */
+static void test_no_oscillation(void) {
+    for (double lux = 0.05; lux <= 120000.0; lux *= 1.07) {
+        lux_range_t range;
+        lux_range_init(&range);
+        for (int i = 0; i < MAX_READINGS_TO_CONVERGE; i++) {
+            take_reading(&range, lux, NULL);
+        }
+        int settled_step = range.step;
+        for (int i = 0; i < 20; i++) {
+            take_reading(&range, lux, NULL);
+            char msg[64];
+            snprintf(msg, sizeof(msg), "%.2f lx, reading %d", lux, i);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(settled_step, range.step, msg);
+        }
+    }
+}
+
+/**
+ * @brief A clipped count asks for a second measurement on a less sensitive step
+ */
+static void test_saturation_remeasures(void) {
+    lux_range_t range;
+    lux_range_init(&range);
+    int step_before = range.step;
+
+    bool saturated = false;
+    float measured = take_reading(&range, 100000.0, &saturated);
+    TEST_ASSERT_TRUE(saturated);
+    TEST_ASSERT_TRUE(range.step > step_before);
+    TEST_ASSERT_FLOAT_WITHIN(resolution_lux(lux_range_setting(&range)) * 1.01, 100000.0, measured);
+
+    // Near but below full scale only steps down; the reading itself is good
+    lux_range_init(&range);
+    TEST_ASSERT_FALSE(lux_range_update(&range, 60000));
+    TEST_ASSERT_EQUAL_INT(step_before + 1, range.step);
+
+    // Already on the least sensitive step there is nothing to re-measure with
+    for (int i = 0; i < 10; i++) {
+        lux_range_update(&range, FULL_SCALE);
+    }
+    int least_sensitive = range.step;
+    TEST_ASSERT_FALSE(lux_range_update(&range, FULL_SCALE));
+    TEST_ASSERT_EQUAL_INT(least_sensitive, range.step);
+}
+
+/**
+ * @brief A conversion time limit skips the slow, most sensitive steps
+ */
+static void test_conversion_limit(void) {
+    lux_range_t range;
+    lux_range_init(&range);
+    for (int i = 0; i < 10; i++) {
+        take_reading(&range, 0.5, NULL);
+    }
+    TEST_ASSERT_TRUE(lux_range_conversion_ms(lux_range_setting(&range)) > 600);
+
+    lux_range_limit_conversion(&range, 180);
+    TEST_ASSERT_TRUE(lux_range_conversion_ms(lux_range_setting(&range)) <= 180);
+    TEST_ASSERT_EQUAL_INT(LUX_RES_HIGH2, lux_range_setting(&range).resolution);
+    // Still resolves dim light to well under a lux
+    float measured = take_reading(&range, 10.0, NULL);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 10.0f, measured);
+
+    // Faster settings are left alone, and a limit nothing meets ends on the fastest
+    lux_range_init(&range);
+    int step = range.step;
+    lux_range_limit_conversion(&range, 180);
+    TEST_ASSERT_EQUAL_INT(step, range.step);
+    lux_range_limit_conversion(&range, 1);
+    TEST_ASSERT_EQUAL_INT(LUX_RES_LOW, lux_range_setting(&range).resolution);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_conversion_matches_datasheet);
+    RUN_TEST(test_converges_across_range);
+    RUN_TEST(test_converges_after_jumps);
+    RUN_TEST(test_no_oscillation);
+    RUN_TEST(test_saturation_remeasures);
+    RUN_TEST(test_conversion_limit);
+    return UNITY_END();
+}
@@ -0,0 +1,74 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for reading_buffer: the buffer size floor and the
+ * high-water mark for small buffers.
+ *
+ * Run with: pio test -e native -f test_reading_buffer
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include "reading_buffer.h"
+
+#define SEND_INTERVAL_S 300
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void test_buffer_size_has_floor(void) {
+    TEST_ASSERT_EQUAL_INT(120, READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, 5));
+    TEST_ASSERT_EQUAL_INT(40, READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, 15));
+    TEST_ASSERT_EQUAL_INT(10, READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, 60));
+    // 240 s and 300 s readings would give 2; the floor keeps room for a late send
+    TEST_ASSERT_EQUAL_INT(READING_BUFFER_MIN_SIZE, READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, 240));
+    TEST_ASSERT_EQUAL_INT(READING_BUFFER_MIN_SIZE, READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, 300));
+}
+
+static void test_high_water_is_three_quarters(void) {
+    TEST_ASSERT_EQUAL_INT(90, reading_buffer_high_water_mark(120));
+    TEST_ASSERT_EQUAL_INT(30, reading_buffer_high_water_mark(40));
+    TEST_ASSERT_EQUAL_INT(6, reading_buffer_high_water_mark(READING_BUFFER_MIN_SIZE));
+}
+
+static void test_small_buffer_mark_is_clamped(void) {
+    // Never the first reading of a cycle, and never only when already full
+    for (int size = 3; size <= 16; size++) {
+        int mark = reading_buffer_high_water_mark(size);
+        TEST_ASSERT_TRUE(mark >= 2);
+        TEST_ASSERT_TRUE(mark < size);
+    }
+    TEST_ASSERT_EQUAL_INT(2, reading_buffer_high_water_mark(3));
+    TEST_ASSERT_EQUAL_INT(2, reading_buffer_high_water_mark(2));
+    TEST_ASSERT_EQUAL_INT(1, reading_buffer_high_water_mark(1));
+}
+
+/**
+ * @brief Readings in one on-time send cycle at the longest intervals stay below the mark
+ */
+static void test_on_time_cycle_does_not_drain_early(void) {
+    static const int intervals_s[] = { 5, 15, 60, 120, 240, 300 };
+    for (int i = 0; i < (int)(sizeof(intervals_s) / sizeof(intervals_s[0])); i++) {
+        int size = READING_BUFFER_SIZE_FOR(SEND_INTERVAL_S, intervals_s[i]);
+        // The send phase can fall anywhere in the interval, so allow one extra reading
+        int per_cycle = SEND_INTERVAL_S / intervals_s[i] + 1;
+        TEST_ASSERT_TRUE(per_cycle < reading_buffer_high_water_mark(size));
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_buffer_size_has_floor);
+    RUN_TEST(test_high_water_is_three_quarters);
+    RUN_TEST(test_small_buffer_mark_is_clamped);
+    RUN_TEST(test_on_time_cycle_does_not_drain_early);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for send_schedule, including a simulation of when a fleet
+ * that lost power together reaches the server.
+ *
+ * Run with: pio test -e native -f test_send_schedule
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "send_schedule.h"
+
+#define SEND_INTERVAL_S 300
+#define JITTER_MAX_S 10
+#define FLEET_SIZE 100
+#define SIM_CYCLES 12                   // An hour of send cycles
+#define WINDOW_S 10                     // Arrivals are counted per window of this length
+#define POWER_RESTORED 1750000000
+
+static uint32_t s_rng_state;
+
+void setUp(void) {
+    s_rng_state = 12345;
+}
+
+void tearDown(void) {
+}
+
+/**
+ * @brief Deterministic stand-in for esp_random (xorshift32)
+ */
+static uint32_t test_random(void) {
+    s_rng_state ^= s_rng_state << 13;
+    s_rng_state ^= s_rng_state >> 17;
+    s_rng_state ^= s_rng_state << 5;
+    return s_rng_state;
+}
+
+static uint32_t lowest_random(void) {
+    return 0;
+}
+
+static uint32_t highest_random(void) {
+    return UINT32_MAX;
+}
+
+static void test_phase_is_stable_and_in_range(void) {
+    uint32_t phase = send_schedule_phase_s("sensor_1", SEND_INTERVAL_S);
+    TEST_ASSERT_TRUE(phase < SEND_INTERVAL_S);
+    TEST_ASSERT_EQUAL_INT(phase, send_schedule_phase_s("sensor_1", SEND_INTERVAL_S));
+    TEST_ASSERT_TRUE(phase != send_schedule_phase_s("sensor_2", SEND_INTERVAL_S));
+    TEST_ASSERT_EQUAL_INT(0, send_schedule_phase_s("sensor_1", 0));
+}
+
+static void test_next_send_follows_phase(void) {
+    uint32_t phase = send_schedule_phase_s("sensor_1", SEND_INTERVAL_S);
+    for (time_t now = POWER_RESTORED; now < POWER_RESTORED + 2 * SEND_INTERVAL_S; now += 7) {
+        time_t next = send_schedule_next_send_time("sensor_1", now, SEND_INTERVAL_S, test_random);
+        TEST_ASSERT_TRUE(next > now);
+        TEST_ASSERT_TRUE(next <= now + SEND_INTERVAL_S + JITTER_MAX_S);
+        TEST_ASSERT_TRUE((uint32_t)((next - phase) % SEND_INTERVAL_S) < JITTER_MAX_S);
+    }
+    TEST_ASSERT_EQUAL_INT(POWER_RESTORED, send_schedule_next_send_time("sensor_1", POWER_RESTORED, 0, test_random));
+}
+
+static void test_retry_delay_bounds(void) {
+    // Drawn from the upper half of 5 s doubling per attempt, capped at 60 s
+    static const uint32_t full_ms[] = { 5000, 10000, 20000, 40000, 60000, 60000 };
+    for (int attempt = 1; attempt <= (int)(sizeof(full_ms) / sizeof(full_ms[0])); attempt++) {
+        TEST_ASSERT_EQUAL_INT(full_ms[attempt - 1] / 2, send_schedule_retry_delay_ms(attempt, lowest_random));
+        uint32_t highest = send_schedule_retry_delay_ms(attempt, highest_random);
+        TEST_ASSERT_TRUE(highest >= full_ms[attempt - 1] / 2 && highest <= full_ms[attempt - 1]);
+    }
+}
+
+static void test_boot_delay_only_after_power_on(void) {
+    TEST_ASSERT_EQUAL_INT(0, send_schedule_boot_delay_ms(false, highest_random));
+    TEST_ASSERT_EQUAL_INT(0, send_schedule_boot_delay_ms(true, lowest_random));
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(send_schedule_boot_delay_ms(true, test_random) < 30000);
+    }
+}
+
+/**
+ * @brief Simulate a fleet that boots together and count arrivals per window
+ *
+ * Every device comes back at the same moment, waits its boot delay, then
+ * sends on its own schedule for an hour. Counting from boot would put all of
+ * them in the same second; the phases should spread them close to evenly
+ * over the interval.
+ */
+static void test_fleet_arrivals_are_spread(void) {
+    int arrivals[SEND_INTERVAL_S / WINDOW_S];
+    memset(arrivals, 0, sizeof(arrivals));
+
+    for (int device = 0; device < FLEET_SIZE; device++) {
+        char sensor_id[16];
+        snprintf(sensor_id, sizeof(sensor_id), "sensor_%d", device + 1);
+        time_t now = POWER_RESTORED + send_schedule_boot_delay_ms(true, test_random) / 1000;
+        for (int cycle = 0; cycle < SIM_CYCLES; cycle++) {
+            now = send_schedule_next_send_time(sensor_id, now, SEND_INTERVAL_S, test_random);
+            arrivals[(now % SEND_INTERVAL_S) / WINDOW_S]++;
+        }
+    }
+
+    int windows = SEND_INTERVAL_S / WINDOW_S;
+    int expected = FLEET_SIZE * SIM_CYCLES / windows;
+    int peak = 0;
+    int empty = 0;
+    for (int i = 0; i < windows; i++) {
+        if (arrivals[i] > peak) {
+            peak = arrivals[i];
+        }
+        if (arrivals[i] == 0) {
+            empty++;
+        }
+    }
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%d devices: peak %d requests per %d s window, %d expected if even, %d windows idle",
+             FLEET_SIZE, peak / SIM_CYCLES, WINDOW_S, expected / SIM_CYCLES, empty);
+    TEST_MESSAGE(msg);
+
+    // Hash phases are random-looking, not evenly spaced, so allow a few times the even share
+    TEST_ASSERT_TRUE(peak <= 3 * expected);
+    TEST_ASSERT_EQUAL_INT(0, empty);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_phase_is_stable_and_in_range);
+    RUN_TEST(test_next_send_follows_phase);
+    RUN_TEST(test_retry_delay_bounds);
+    RUN_TEST(test_boot_delay_only_after_power_on);
+    RUN_TEST(test_fleet_arrivals_are_spread);
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for sun_schedule against the NOAA Solar Calculator.
+ *
+ * Expected times are NOAA's, rounded to the minute, for the solstices at
+ * mid-latitude sites in both hemispheres and the tropics, plus the polar
+ * day and night cases at Tromsø.
+ *
+ * Run with: pio test -e native -f test_sun_schedule
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "sun_schedule.h"
+#include "tz_table.h"
+
+#define TOLERANCE_S 120     // NOAA rounds to the minute; the module claims about a minute
+
+#define CHICAGO 41.8781, -87.6298
+#define SYDNEY -33.8688, 151.2093
+#define HONOLULU 21.3069, -157.8583
+#define TROMSO 69.6492, 18.9553
+
+/**
+ * @brief One expected sunrise and sunset, as local wall times
+ */
+typedef struct {
+    const char *name;
+    int year, month, day;
+    double latitude, longitude;
+    int utc_offset_h;                   // Local standard or daylight offset on that date
+    int rise_h, rise_m;
+    int set_h, set_m;
+} sun_case_t;
+
+static const sun_case_t CASES[] = {
+    { "Chicago June solstice",    2025, 6, 21,  CHICAGO,  -5,  5, 15, 20, 29 },
+    { "Chicago December solstice", 2025, 12, 21, CHICAGO, -6,  7, 15, 16, 23 },
+    { "Sydney December solstice", 2025, 12, 21, SYDNEY,   11,  5, 41, 20,  5 },
+    { "Sydney June solstice",     2025, 6, 21,  SYDNEY,   10,  7,  0, 16, 54 },
+    { "Honolulu June solstice",   2025, 6, 21,  HONOLULU, -10, 5, 50, 19, 16 },
+    { "Honolulu December solstice", 2025, 12, 21, HONOLULU, -10, 7, 5, 17, 55 },
+};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static time_t local_to_utc(int year, int month, int day, int hour, int minute, int utc_offset_h) {
+    return (time_t)(tz_table_days_from_civil(year, month, day) * 86400LL
+                    + (hour - utc_offset_h) * 3600LL + minute * 60LL);
+}
+
+static void test_matches_noaa(void) {
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        const sun_case_t *c = &CASES[i];
+        time_t sunrise = 0;
+        time_t sunset = 0;
+        sun_day_type_t type = sun_schedule_compute(c->year, c->month, c->day, c->latitude, c->longitude,
+                                                   SUN_ZENITH_OFFICIAL, &sunrise, &sunset);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(SUN_DAY_NORMAL, type, c->name);
+
+        time_t expected_rise = local_to_utc(c->year, c->month, c->day, c->rise_h, c->rise_m, c->utc_offset_h);
+        time_t expected_set = local_to_utc(c->year, c->month, c->day, c->set_h, c->set_m, c->utc_offset_h);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s sunrise", c->name);
+        TEST_ASSERT_INT_WITHIN_MESSAGE(TOLERANCE_S, expected_rise, sunrise, msg);
+        snprintf(msg, sizeof(msg), "%s sunset", c->name);
+        TEST_ASSERT_INT_WITHIN_MESSAGE(TOLERANCE_S, expected_set, sunset, msg);
+    }
+}
+
+static void test_tromso_polar_night(void) {
+    time_t sunrise = 1;
+    time_t sunset = 1;
+    TEST_ASSERT_EQUAL_INT(SUN_DAY_POLAR_NIGHT,
+                          sun_schedule_compute(2025, 12, 21, TROMSO, SUN_ZENITH_OFFICIAL, &sunrise, &sunset));
+    TEST_ASSERT_EQUAL_INT(SUN_DAY_POLAR_NIGHT,
+                          sun_schedule_compute(2025, 12, 1, TROMSO, SUN_ZENITH_OFFICIAL, &sunrise, &sunset));
+}
+
+static void test_tromso_midnight_sun(void) {
+    time_t sunrise = 1;
+    time_t sunset = 1;
+    TEST_ASSERT_EQUAL_INT(SUN_DAY_MIDNIGHT_SUN,
+                          sun_schedule_compute(2025, 6, 21, TROMSO, SUN_ZENITH_OFFICIAL, &sunrise, &sunset));
+    TEST_ASSERT_EQUAL_INT(SUN_DAY_MIDNIGHT_SUN,
+                          sun_schedule_compute(2025, 7, 1, TROMSO, SUN_ZENITH_OFFICIAL, &sunrise, &sunset));
+}
+
+static void test_tromso_equinox_is_normal(void) {
+    time_t sunrise = 0;
+    time_t sunset = 0;
+    TEST_ASSERT_EQUAL_INT(SUN_DAY_NORMAL,
+                          sun_schedule_compute(2025, 3, 20, TROMSO, SUN_ZENITH_OFFICIAL, &sunrise, &sunset));
+    // Refraction makes the equinox day a little over 12 hours, more so far north
+    TEST_ASSERT_INT_WITHIN(20 * 60, 12 * 3600 + 20 * 60, sunset - sunrise);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_noaa);
+    RUN_TEST(test_tromso_polar_night);
+    RUN_TEST(test_tromso_midnight_sun);
+    RUN_TEST(test_tromso_equinox_is_normal);
+    return UNITY_END();
+}
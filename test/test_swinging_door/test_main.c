@@ -0,0 +1,189 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for swinging_door: the error bound, which readings are
+ * always kept, timestamp breaks, and a small benchmark over the partly
+ * cloudy trace.
+ *
+ * Run with: pio test -e native -f test_swinging_door
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "swinging_door.h"
+#include "../data/trace_partly_cloudy.h"
+
+#define TRACE_START 1750000000
+#define READING_INTERVAL_S 15
+#define BATCH_SIZE 20                   // Five minutes of readings, one upload
+#define TRACE_READINGS (TRACE_PARTLY_CLOUDY_SECONDS / READING_INTERVAL_S)
+#define FLOAT_SLACK_LUX 0.5f            // Single precision rounding at daylight levels
+#define BENCH_ROUNDS 200
+
+static sensor_reading_t s_original[TRACE_PARTLY_CLOUDY_SECONDS];
+static sensor_reading_t s_compressed[TRACE_PARTLY_CLOUDY_SECONDS];
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/**
+ * @brief Fill s_original with the trace sampled every interval_s seconds
+ */
+static int load_trace(int interval_s) {
+    int count = 0;
+    for (int s = 0; s < TRACE_PARTLY_CLOUDY_SECONDS; s += interval_s) {
+        memset(&s_original[count], 0, sizeof(sensor_reading_t));
+        s_original[count].timestamp = TRACE_START + s;
+        s_original[count].lux = trace_partly_cloudy[s];
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Largest gap between a reading and the line through the kept readings around it
+ *
+ * Assumes timestamps increase, as they do within a batch without breaks.
+ */
+static float max_interpolation_error(const sensor_reading_t *original, int count,
+                                     const sensor_reading_t *kept, int kept_count) {
+    float max_error = 0.0f;
+    int k = 0;
+    for (int i = 0; i < count; i++) {
+        while (k + 1 < kept_count && kept[k + 1].timestamp <= original[i].timestamp) {
+            k++;
+        }
+        float estimate = kept[k].lux;
+        if (k + 1 < kept_count) {
+            float fraction = (float)(original[i].timestamp - kept[k].timestamp) /
+                             (float)(kept[k + 1].timestamp - kept[k].timestamp);
+            estimate += (kept[k + 1].lux - kept[k].lux) * fraction;
+        }
+        max_error = fmaxf(max_error, fabsf(estimate - original[i].lux));
+    }
+    return max_error;
+}
+
+static void test_error_within_bound_on_trace(void) {
+    static const float bounds[] = { 10.0f, 50.0f, 250.0f, 1000.0f, 5000.0f };
+    int count = load_trace(READING_INTERVAL_S);
+
+    for (size_t b = 0; b < sizeof(bounds) / sizeof(bounds[0]); b++) {
+        int total_kept = 0;
+        for (int start = 0; start < count; start += BATCH_SIZE) {
+            int batch = count - start < BATCH_SIZE ? count - start : BATCH_SIZE;
+            memcpy(s_compressed, &s_original[start], batch * sizeof(sensor_reading_t));
+            int kept = swinging_door_compress(s_compressed, batch, bounds[b]);
+            total_kept += kept;
+
+            float error = max_interpolation_error(&s_original[start], batch, s_compressed, kept);
+            char msg[96];
+            snprintf(msg, sizeof(msg), "bound %.0f lx, batch at %d: error %.1f lx", bounds[b], start, error);
+            TEST_ASSERT_TRUE_MESSAGE(error <= bounds[b] + FLOAT_SLACK_LUX, msg);
+            TEST_ASSERT_TRUE_MESSAGE(kept >= 2, msg);
+        }
+        char msg[96];
+        snprintf(msg, sizeof(msg), "bound %.0f lx: kept %d of %d readings", bounds[b], total_kept, count);
+        TEST_MESSAGE(msg);
+    }
+}
+
+static void test_endpoints_kept_in_order(void) {
+    int count = load_trace(READING_INTERVAL_S);
+    memcpy(s_compressed, s_original, BATCH_SIZE * sizeof(sensor_reading_t));
+    int kept = swinging_door_compress(s_compressed, BATCH_SIZE, 1e9f);
+
+    TEST_ASSERT_EQUAL_INT(2, kept);
+    TEST_ASSERT_EQUAL_INT(s_original[0].timestamp, s_compressed[0].timestamp);
+    TEST_ASSERT_EQUAL_INT(s_original[BATCH_SIZE - 1].timestamp, s_compressed[1].timestamp);
+
+    // Whatever the bound, kept readings are a subsequence of the input
+    memcpy(s_compressed, s_original, count * sizeof(sensor_reading_t));
+    kept = swinging_door_compress(s_compressed, count, 100.0f);
+    TEST_ASSERT_EQUAL_INT(s_original[0].timestamp, s_compressed[0].timestamp);
+    TEST_ASSERT_EQUAL_INT(s_original[count - 1].timestamp, s_compressed[kept - 1].timestamp);
+    for (int i = 1; i < kept; i++) {
+        TEST_ASSERT_TRUE(s_compressed[i].timestamp > s_compressed[i - 1].timestamp);
+    }
+}
+
+static void test_no_compression_cases(void) {
+    sensor_reading_t readings[3] = {
+        { .timestamp = 100, .lux = 5.0f },
+        { .timestamp = 115, .lux = 5.0f },
+        { .timestamp = 130, .lux = 5.0f },
+    };
+    TEST_ASSERT_EQUAL_INT(3, swinging_door_compress(readings, 3, 0.0f));
+    TEST_ASSERT_EQUAL_INT(2, swinging_door_compress(readings, 2, 100.0f));
+    TEST_ASSERT_EQUAL_INT(2, swinging_door_compress(readings, 3, 100.0f));
+}
+
+/**
+ * @brief Readings whose timestamp doesn't move forward are kept with the one before them
+ */
+static void test_timestamp_breaks(void) {
+    sensor_reading_t readings[] = {
+        { .timestamp = 10, .lux = 1.0f },
+        { .timestamp = 20, .lux = 1.0f },
+        { .timestamp = 5, .lux = 1.0f },    // Clock stepped back
+        { .timestamp = 15, .lux = 1.0f },
+        { .timestamp = 25, .lux = 1.0f },
+        { .timestamp = 25, .lux = 1.0f },   // Repeated timestamp
+        { .timestamp = 35, .lux = 1.0f },
+        { .timestamp = 45, .lux = 1.0f },
+    };
+    static const time_t expected[] = { 10, 20, 5, 25, 25, 45 };
+    int kept = swinging_door_compress(readings, sizeof(readings) / sizeof(readings[0]), 10.0f);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(expected) / sizeof(expected[0]), kept);
+    for (int i = 0; i < kept; i++) {
+        TEST_ASSERT_EQUAL_INT(expected[i], readings[i].timestamp);
+    }
+}
+
+/**
+ * @brief Time per reading on the one-second trace, in upload-sized batches
+ */
+static void test_benchmark_trace(void) {
+    int count = load_trace(1);
+    int kept_total = 0;
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        kept_total = 0;
+        memcpy(s_compressed, s_original, count * sizeof(sensor_reading_t));
+        for (int first = 0; first < count; first += BATCH_SIZE) {
+            int batch = count - first < BATCH_SIZE ? count - first : BATCH_SIZE;
+            kept_total += swinging_door_compress(&s_compressed[first], batch, 250.0f);
+        }
+    }
+    double elapsed_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%d readings x %d rounds: %.1f ns per reading, kept %d (%.0f%%) at 250 lx",
+             count, BENCH_ROUNDS, elapsed_s * 1e9 / ((double)count * BENCH_ROUNDS),
+             kept_total, 100.0 * kept_total / count);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(kept_total < count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_error_within_bound_on_trace);
+    RUN_TEST(test_endpoints_kept_in_order);
+    RUN_TEST(test_no_compression_cases);
+    RUN_TEST(test_timestamp_breaks);
+    RUN_TEST(test_benchmark_trace);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+/**
+* @file test_main.c
+ *
+ * Host-side tests for tz_table: every zone is checked against the C
+ * library's localtime_r(), hourly across 2015-2072 and to the second at
+ * each DST transition.
+ *
+ * Run with: pio test -e native -f test_tz_table
+ *
+ * Copyright (c) 2025 Caden Howell (cadenhowell@gmail.com)
+ *
+ * Developed with assistance from Claude Sonnet 4 (2025).
+ *
+ * Apache 2.0 Licensed as described in the file LICENSE
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tz_table.h"
+
+#define FIRST_YEAR 2015
+#define LAST_YEAR 2072
+#define STEP_S 3600
+
+static const char *const ZONES[] = {
+    "CST6CDT,M3.2.0/2,M11.1.0/2",               // Chicago, the default
+    "EST5EDT,M3.2.0,M11.1.0",                   // New York
+    "PST8PDT,M3.2.0,M11.1.0",                   // Los Angeles
+    "MST7",                                     // Phoenix, no DST
+    "HST10",                                    // Honolulu
+    "GMT0BST,M3.5.0/1,M10.5.0",                 // London
+    "CET-1CEST,M3.5.0,M10.5.0/3",               // Berlin
+    "AEST-10AEDT,M10.1.0,M4.1.0/3",             // Sydney, DST across the new year
+    "NZST-12NZDT,M9.5.0,M4.1.0/3",              // Auckland
+    "IST-5:30",                                 // Kolkata, half-hour offset
+    "NST3:30NDT,M3.2.0,M11.1.0",                // St. John's
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0",     // Lord Howe, 30 minute DST
+};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void use_libc_zone(const char *posix_tz) {
+    setenv("TZ", posix_tz, 1);
+    tzset();
+}
+
+/**
+ * @brief Compare tz_table with localtime_r() at one instant
+ */
+static void check_instant(const char *zone, time_t t) {
+    struct tm expected;
+    struct tm actual;
+    localtime_r(&t, &expected);
+    tz_table_utc_to_local(t, &actual);
+    bool is_dst = false;
+    int32_t offset = tz_table_utc_offset(t, &is_dst);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s at %lld", zone, (long long)t);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_gmtoff, offset, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_isdst > 0, is_dst, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_isdst > 0, actual.tm_isdst > 0, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_year, actual.tm_year, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_mon, actual.tm_mon, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_mday, actual.tm_mday, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_hour, actual.tm_hour, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_min, actual.tm_min, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_sec, actual.tm_sec, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_wday, actual.tm_wday, msg);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected.tm_yday, actual.tm_yday, msg);
+}
+
+/**
+ * @brief Find the first second in (lo, hi] where libc's UTC offset differs from lo's
+ */
+static time_t find_libc_transition(time_t lo, time_t hi) {
+    struct tm tm;
+    localtime_r(&lo, &tm);
+    long lo_offset = tm.tm_gmtoff;
+    while (hi - lo > 1) {
+        time_t mid = lo + (hi - lo) / 2;
+        localtime_r(&mid, &tm);
+        if (tm.tm_gmtoff == lo_offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+
+static void check_zone(const char *zone) {
+    use_libc_zone(zone);
+    TEST_ASSERT_TRUE_MESSAGE(tz_table_init(zone), zone);
+
+    time_t start = (time_t)(tz_table_days_from_civil(FIRST_YEAR, 1, 1) * 86400LL);
+    time_t end = (time_t)(tz_table_days_from_civil(LAST_YEAR + 1, 1, 1) * 86400LL);
+    int transitions = 0;
+
+    struct tm tm;
+    localtime_r(&start, &tm);
+    long previous_offset = tm.tm_gmtoff;
+    for (time_t t = start; t < end; t += STEP_S) {
+        check_instant(zone, t);
+
+        localtime_r(&t, &tm);
+        if (tm.tm_gmtoff != previous_offset) {
+            time_t change = find_libc_transition(t - STEP_S, t);
+            check_instant(zone, change - 1);
+            check_instant(zone, change);
+            transitions++;
+            previous_offset = tm.tm_gmtoff;
+        }
+    }
+
+    // Zones with DST change twice a year; fixed zones never
+    bool has_dst = strchr(zone, ',') != NULL;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(has_dst ? 2 * (LAST_YEAR - FIRST_YEAR + 1) : 0, transitions, zone);
+}
+
+static void test_zones_match_libc(void) {
+    for (size_t i = 0; i < sizeof(ZONES) / sizeof(ZONES[0]); i++) {
+        check_zone(ZONES[i]);
+    }
+}
+
+static void test_days_from_civil(void) {
+    TEST_ASSERT_EQUAL_INT(0, tz_table_days_from_civil(1970, 1, 1));
+    TEST_ASSERT_EQUAL_INT(-1, tz_table_days_from_civil(1969, 12, 31));
+    TEST_ASSERT_EQUAL_INT(11016, tz_table_days_from_civil(2000, 2, 29));
+    TEST_ASSERT_EQUAL_INT(24855, tz_table_days_from_civil(2038, 1, 19));  // 32-bit time_t limit
+}
+
+static void test_invalid_zone_falls_back_to_utc(void) {
+    TEST_ASSERT_FALSE(tz_table_init("not a zone"));
+    bool is_dst = true;
+    TEST_ASSERT_EQUAL_INT(0, tz_table_utc_offset(1751328000, &is_dst));
+    TEST_ASSERT_FALSE(is_dst);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_days_from_civil);
+    RUN_TEST(test_zones_match_libc);
+    RUN_TEST(test_invalid_zone_falls_back_to_utc);
+    return UNITY_END();
+}